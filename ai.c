@@ -0,0 +1,227 @@
+/**
+@file       ai.c
+@authors    Jordan Griffiths (jlg108) & Jonty Trombik (jat157)
+@date       17 October 2026
+
+@brief      Single-player AI opponent. Fleet placement and targeting are
+            split into increments small enough to run inside one game loop
+            tick alongside the display. Strikes are chosen from the
+            placement density kept by the target module.
+**/
+
+#include "ai.h"
+
+
+/**
+Score one column of the target board and keep a random pick among the
+best cells, using the placement density.
+@param ai AI state to operate on.
+@param x column to scan
+*/
+static void ai_scan_column(Ai* ai, uint8_t x)
+{
+    uint8_t y;
+    for (y = 0; y < BOARD_HEIGHT; y++) {
+        uint16_t score = target_score(&ai->target, x, y);
+        if (score > ai->best_score) {
+            ai->best_score = score;
+            ai->best_ties = 0;
+        }
+        if (score != 0 && score == ai->best_score) {
+            //Reservoir sampling picks uniformly among equal cells
+            ai->best_ties++;
+            if (random_next(&ai->rng) % ai->best_ties == 0) {
+                ai->board.cursor = tinygl_point(x, y);
+            }
+        }
+    }
+}
+
+
+/**
+Start the AI's turn, once its reply to the player's strike is known.
+@param ai AI state to operate on.
+*/
+static void ai_begin_turn(Ai* ai)
+{
+    ai->scan_col = 0;
+    ai->best_score = 0;
+    ai->best_ties = 0;
+    ai->turn_ticks = 0;
+    ai->state = AI_AIMING;
+}
+
+
+/**
+Perform one increment of AI work.
+@param ai AI state to operate on.
+*/
+static void ai_step(Ai* ai)
+{
+    if (ai->state == AI_PLACING) {
+        //One fleet attempt per tick
+        if (random_fleet_attempt(&ai->board, &ai->rng)) {
+            ai->state = AI_DEFENDING;
+        }
+
+    } else if (ai->inbox != NO_POSITION) {
+        //Answer the player's strike once the fleet is in place, then take our turn
+        tinygl_point_t shot = ir_decode_strike(ai->inbox);
+        strike_result_t result = is_hit(&ai->board, shot);
+        ai->outbox = ir_encode_result(result);
+        ai->inbox = NO_POSITION;
+        if (result == FLEET_SUNK) {
+            ai->state = AI_IDLE;
+        } else {
+            ai_begin_turn(ai);
+        }
+
+    } else if (ai->record_pending) {
+        target_record(&ai->target, ai->board.strike_position, ai->last_result);
+        ai->record_pending = FALSE;
+
+    } else if (ai->state == AI_AIMING) {
+        ai->turn_ticks++;
+        if (ai->scan_col < BOARD_WIDTH) {
+            ai_scan_column(ai, ai->scan_col);
+            ai->scan_col++;
+        } else if (ai->turn_ticks >= AI_TURN_TICKS && ai->outbox == NO_POSITION
+                   && is_valid_strike(&ai->board)) {
+            //Fire only once the player has collected our last reply
+            ai->outbox = ENCODE_POS(ai->board.cursor.x, ai->board.cursor.y);
+            ai->state = AI_FIRED;
+        }
+    }
+}
+
+
+/**
+Start a new game against the AI. The AI places its fleet over the
+following ticks.
+@param ai AI state to operate on.
+@param seed random seed (e.g. drawn from the input timing entropy pool)
+*/
+void ai_init(Ai* ai, uint32_t seed)
+{
+    board_init(&ai->board);
+    target_init(&ai->target);
+    ai->rng = seed ? seed : 1;
+    ai->inbox = NO_POSITION;
+    ai->outbox = NO_POSITION;
+    ai->record_pending = FALSE;
+    ai->worst_cycles = 0;
+    ai->state = AI_PLACING;
+}
+
+
+/**
+Perform one bounded increment of AI work. Called once per game loop tick.
+@param ai AI state to operate on.
+*/
+void ai_task(Ai* ai)
+{
+    timer_tick_t start;
+    uint32_t cycles;
+
+    if (ai->state == AI_IDLE) {
+        return;
+    }
+
+    start = timer_get();
+    ai_step(ai);
+    cycles = (uint32_t) (timer_tick_t) (timer_get() - start) * PROFILE_CYCLES_PER_TICK;
+    if (cycles > ai->worst_cycles) {
+        ai->worst_cycles = cycles;
+    }
+}
+
+
+/**
+Pass a status code from the player to the AI
+@param ai AI state to operate on.
+@param status status code sent by the player
+*/
+void ai_send_status(Ai* ai, states status)
+{
+    switch (status) {
+        case HIT_S :
+        case MISS_S :
+        case SUNK_S :
+        case FLEET_SUNK_S :
+            /** Result of the AI's strike, which also says whether the AI has won */
+            ai->last_result = ir_decode_result(status);
+            if (IS_HIT_RESULT(ai->last_result)) {
+                add_hit(&ai->board, ai->last_result);
+            } else {
+                add_miss(&ai->board);
+            }
+            //Density update is left to the next ai_task call
+            ai->record_pending = TRUE;
+            ai->state = is_winner(&ai->board) ? AI_IDLE : AI_DEFENDING;
+            break;
+
+        case PLAY_AGAIN_S :
+            ai->state = AI_IDLE;
+            break;
+
+        default :
+            break;
+    }
+}
+
+
+/**
+Get status code sent by the AI (or special code for no response).
+@param ai AI state to operate on.
+@return status code (or special NORESPONSE_S code if nothing sent)
+*/
+states ai_get_status(Ai* ai)
+{
+    if (ai->outbox != NO_POSITION && ai->outbox >= NORESPONSE_S) {
+        states status = ai->outbox;
+        ai->outbox = NO_POSITION;
+        return status;
+    }
+
+    return NORESPONSE_S;
+}
+
+
+/**
+Pass the player's strike to the AI.
+@param ai AI state to operate on.
+@param pos tinygl_point representing position of strike
+*/
+void ai_send_strike(Ai* ai, tinygl_point_t pos)
+{
+    ai->inbox = ENCODE_POS(pos.x, pos.y);
+}
+
+
+/**
+Get strike position chosen by the AI.
+@param ai AI state to operate on.
+@return encoded position, or special NO_POSITION if no strike ready
+*/
+uint8_t ai_get_position(Ai* ai)
+{
+    if (ai->outbox < NORESPONSE_S) {
+        uint8_t position = ai->outbox;
+        ai->outbox = NO_POSITION;
+        return position;
+    }
+
+    return NO_POSITION;
+}
+
+
+/**
+Worst-case CPU cycles used by a single ai_task call since ai_init.
+Resolution is one timer tick (PROFILE_CYCLES_PER_TICK cycles).
+@param ai AI state to operate on.
+@return worst-case cycles per tick
+*/
+uint32_t ai_worst_cycles(Ai* ai)
+{
+    return ai->worst_cycles;
+}
@@ -0,0 +1,118 @@
+/**
+@file       ai.h
+@authors    Jordan Griffiths (jlg108) & Jonty Trombik (jat157)
+@date       17 October 2026
+
+@brief      Single-player AI opponent definitions. The AI stands in for the
+            other UCFK4 board: it takes the same status and strike messages
+            that would otherwise be sent over IR, and does its work in small
+            increments, one per game loop tick.
+**/
+
+#ifndef AI_H
+#define AI_H
+
+
+/** Required library modules */
+#include "system.h"
+#include "timer.h"
+#include "tinygl.h"
+
+
+/** Application Modules */
+#include "board.h"
+#include "ir_handler.h"
+#include "profile.h"
+#include "target.h"
+
+
+/** Minimum number of ai_task calls spent on each AI turn, so the turn is visible */
+#define AI_TURN_TICKS 450
+
+
+/** AI opponent states */
+typedef enum ai_state {
+    AI_IDLE,                            //Not playing
+    AI_PLACING,                         //Placing fleet, one attempt per tick
+    AI_DEFENDING,                       //Fleet placed, answering the player's strikes
+    AI_AIMING,                          //Scanning target board, one column per tick
+    AI_FIRED,                           //Strike sent, awaiting its result
+} ai_state_t;
+
+
+/** Structure definition for the state of one AI opponent */
+typedef struct ai {
+    ai_state_t state;                   //Current AI state
+    Board board;                        //AI fleet, strike cursor and target board
+    Targeter target;                    //Placement density over the target board
+    uint32_t rng;                       //xorshift random state (never zero)
+    uint8_t inbox;                      //Encoded strike from player, NO_POSITION if none
+    uint8_t outbox;                     //Message for player, NO_POSITION if none
+    strike_result_t last_result;        //Result of the AI's last strike
+    bool record_pending;                //TRUE until last_result is added to the density
+    uint8_t scan_col;                   //Next column to scan while aiming
+    uint16_t best_score;                //Best cell score found in this scan
+    uint8_t best_ties;                  //Number of cells sharing the best score
+    uint16_t turn_ticks;                //Ticks spent on the current turn
+    uint32_t worst_cycles;              //Most CPU cycles used by one ai_task call
+} Ai;
+
+
+/**
+Start a new game against the AI. The AI places its fleet over the
+following ticks.
+@param ai AI state to operate on.
+@param seed random seed (e.g. drawn from the input timing entropy pool)
+*/
+void ai_init(Ai* ai, uint32_t seed);
+
+
+/**
+Perform one bounded increment of AI work. Called once per game loop tick.
+@param ai AI state to operate on.
+*/
+void ai_task(Ai* ai);
+
+
+/**
+Pass a status code from the player to the AI
+@param ai AI state to operate on.
+@param status status code sent by the player
+*/
+void ai_send_status(Ai* ai, states status);
+
+
+/**
+Get status code sent by the AI (or special code for no response).
+@param ai AI state to operate on.
+@return status code (or special NORESPONSE_S code if nothing sent)
+*/
+states ai_get_status(Ai* ai);
+
+
+/**
+Pass the player's strike to the AI.
+@param ai AI state to operate on.
+@param pos tinygl_point representing position of strike
+*/
+void ai_send_strike(Ai* ai, tinygl_point_t pos);
+
+
+/**
+Get strike position chosen by the AI.
+@param ai AI state to operate on.
+@return encoded position, or special NO_POSITION if no strike ready
+*/
+uint8_t ai_get_position(Ai* ai);
+
+
+/**
+Worst-case CPU cycles used by a single ai_task call since ai_init.
+Resolution is one timer tick (PROFILE_CYCLES_PER_TICK cycles).
+@param ai AI state to operate on.
+@return worst-case cycles per tick
+*/
+uint32_t ai_worst_cycles(Ai* ai);
+
+
+#endif
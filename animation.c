@@ -0,0 +1,140 @@
+/**
+@file       animation.c
+@authors    Jordan Griffiths (jlg108) & Jonty Trombik (jat157)
+@date       17 October 2026
+
+@brief      Animation engine and precomputed animation frame tables.
+            Frames are read from program memory and blitted one column at
+            a time, so every frame costs at most DISPLAY_WIDTH blits.
+**/
+
+#include "animation.h"
+
+
+/** Splash ship scrolling across the screen, then a cue for the start prompt */
+static const uint8_t ship_frames[] PROGMEM =
+{
+    0x00,
+    0x08, 0x01,
+    0x1C, 0x01, 0x03, 0x01,
+    0x1C, 0x02, 0x07, 0x03,
+    0x1F, 0x01, 0x01, 0x05, 0x0F, 0x07,
+    0x1F, 0x02, 0x02, 0x0A, 0x1F, 0x0F,
+    0x1F, 0x04, 0x05, 0x15, 0x3F, 0x1F,
+    0x1F, 0x08, 0x0A, 0x2A, 0x7F, 0x3E,
+    0x1F, 0x10, 0x14, 0x54, 0x7E, 0x7C,
+    0x1F, 0x20, 0x28, 0x28, 0x7C, 0x78,
+    0x1F, 0x40, 0x50, 0x50, 0x78, 0x70,
+    0x1F, 0x00, 0x20, 0x20, 0x70, 0x60,
+    0x1E, 0x40, 0x40, 0x60, 0x40,
+    0x1E, 0x00, 0x00, 0x40, 0x00,
+    0x08, 0x00,
+    ANIM_CUE,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+
+/** Tick drawn one dot at a time, held for three frames */
+static const uint8_t tick_frames[] PROGMEM =
+{
+    0x04, 0x40,
+    0x08, 0x20,
+    0x10, 0x10,
+    0x08, 0x28,
+    0x04, 0x44,
+    0x02, 0x02,
+    0x01, 0x01,
+    0x00,
+    0x00,
+    0x00,
+};
+
+
+/** Cross flashing twice */
+static const uint8_t cross_frames[] PROGMEM =
+{
+    0x1F, 0x22, 0x14, 0x08, 0x14, 0x22,
+    0x1F, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x1F, 0x22, 0x14, 0x08, 0x14, 0x22,
+    0x1F, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+
+/** Target closing in and out */
+static const uint8_t target_frames[] PROGMEM =
+{
+    0x1F, 0x63, 0x49, 0x1C, 0x49, 0x63,
+    0x0E, 0x41, 0x00, 0x41,
+};
+
+
+/** Animations */
+const Animation anim_ship PROGMEM = {ship_frames, 40, DISPLAY_TASK_RATE / SHIP_STEP_RATE, TRUE};
+const Animation anim_tick PROGMEM = {tick_frames, 10, DISPLAY_TASK_RATE / TICK_STEP_RATE, FALSE};
+const Animation anim_cross PROGMEM = {cross_frames, 4, DISPLAY_TASK_RATE / CROSS_STEP_RATE, FALSE};
+const Animation anim_target PROGMEM = {target_frames, 2, DISPLAY_TASK_RATE / TARGET_STEP_RATE, TRUE};
+
+
+/** Playback state */
+static Animation current;               //Animation being played (copied from program memory)
+static const uint8_t* next_data;        //Next frame to show
+static uint8_t next_frame;              //Index of next frame to show
+static uint16_t next_time;              //Timestamp at which the next frame is due
+
+
+/**
+Start playing an animation from its first frame, replacing any animation
+already playing.
+@param anim animation to play (program memory)
+@param now current timestamp (display ticks)
+*/
+void anim_start(const Animation* anim, uint16_t now)
+{
+    memcpy_P(&current, anim, sizeof(Animation));
+    next_data = current.frames;
+    next_frame = 0;
+    next_time = now;
+    blit_clear();
+}
+
+
+/**
+Show every frame of the playing animation that is due by a timestamp.
+@param now current timestamp (display ticks)
+@return ANIM_FINISHED once a non-looping animation has ended,
+ANIM_CUED if a cue frame was shown, ANIM_PLAYING otherwise
+*/
+anim_status_t anim_update(uint16_t now)
+{
+    anim_status_t status = ANIM_PLAYING;
+
+    while ((int16_t) (now - next_time) >= 0) {
+        uint8_t header, col;
+
+        if (next_frame == current.num_frames) {
+            if (!current.loop) {
+                return ANIM_FINISHED;
+            }
+            //Restart from a blank display, as the first frame expects
+            next_data = current.frames;
+            next_frame = 0;
+            blit_clear();
+        }
+
+        header = pgm_read_byte(next_data++);
+        if (header & ANIM_CUE) {
+            status = ANIM_CUED;
+        }
+        for (col = 0; col < DISPLAY_WIDTH; col++) {
+            if (header & BIT(col)) {
+                blit_column(col, pgm_read_byte(next_data++));
+            }
+        }
+
+        next_frame++;
+        next_time += current.period;
+    }
+
+    return status;
+}
@@ -0,0 +1,82 @@
+/**
+@file       animation.h
+@authors    Jordan Griffiths (jlg108) & Jonty Trombik (jat157)
+@date       17 October 2026
+
+@brief      Animation engine definitions. Animations are sequences of
+            delta-encoded frames held in program memory, played back by a
+            single frame-advance routine driven by a timestamp.
+**/
+
+#ifndef ANIMATION_H
+#define ANIMATION_H
+
+
+/** Required library modules */
+#include "system.h"
+#include <avr/pgmspace.h>
+
+
+/** Application Modules */
+#include "display_handler.h"
+
+
+/** Animation frame rates (frames per second) */
+#define TICK_STEP_RATE 10
+#define CROSS_STEP_RATE 2
+#define TARGET_STEP_RATE 3
+#define SHIP_STEP_RATE 4
+
+
+/** Frame header flag marking a cue for the caller (e.g. switch to text) */
+#define ANIM_CUE 0x80
+
+
+/** Outcome of advancing an animation */
+typedef enum anim_status {
+    ANIM_FINISHED,                      //Non-looping animation has ended
+    ANIM_PLAYING,                       //Animation still running
+    ANIM_CUED,                          //A frame with a cue was shown in this update
+} anim_status_t;
+
+
+/**
+Structure definition for an animation. Each frame is a header byte
+holding a mask of the columns that change (bits 0-4) and the ANIM_CUE
+flag, followed by the new bitmap of each changed column in order. The
+first frame is relative to a blank display.
+*/
+typedef struct animation {
+    const uint8_t* frames;              //Delta-encoded frames (program memory)
+    uint8_t num_frames;                 //Number of frames
+    uint8_t period;                     //Display ticks per frame
+    bool loop;                          //TRUE to restart after the last frame
+} Animation;
+
+
+/** Animations (program memory) */
+extern const Animation anim_ship PROGMEM;
+extern const Animation anim_tick PROGMEM;
+extern const Animation anim_cross PROGMEM;
+extern const Animation anim_target PROGMEM;
+
+
+/**
+Start playing an animation from its first frame, replacing any animation
+already playing.
+@param anim animation to play (program memory)
+@param now current timestamp (display ticks)
+*/
+void anim_start(const Animation* anim, uint16_t now);
+
+
+/**
+Show every frame of the playing animation that is due by a timestamp.
+@param now current timestamp (display ticks)
+@return ANIM_FINISHED once a non-looping animation has ended,
+ANIM_CUED if a cue frame was shown, ANIM_PLAYING otherwise
+*/
+anim_status_t anim_update(uint16_t now);
+
+
+#endif
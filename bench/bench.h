@@ -0,0 +1,34 @@
+/**
+@file       bench.h
+@authors    Jordan Griffiths (jlg108) & Jonty Trombik (jat157)
+@date       17 October 2026
+
+@brief      Shared helpers for the host benchmarks.
+**/
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+
+/** Results are added here so the compiler cannot drop timed work */
+static volatile unsigned long bench_sink;
+
+
+/**
+Read a monotonic clock
+@return seconds since an arbitrary start
+*/
+static inline double bench_seconds(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+
+#endif
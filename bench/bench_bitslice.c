@@ -0,0 +1,307 @@
+/**
+@file       bench_bitslice.c
+@authors    Jordan Griffiths (jlg108) & Jonty Trombik (jat157)
+@date       17 October 2026
+
+@brief      Host benchmark of a bit-sliced game simulator. Bit g of each
+            lane word belongs to game g, so is_hit, add_hit and is_winner
+            run for 64 games per word operation, or 256 when the compiler
+            targets AVX2. Fleets come from auto_place() in board.c, and
+            every game's shots to win is checked against the same game
+            played one at a time with is_hit().
+
+            Games in a batch share one random strike order, so this
+            measures the random order strategy; each game still has its
+            own fleet.
+**/
+
+#include "bench.h"
+#include "board.h"
+
+
+/** Cells on the board, the most shots a game can take */
+#define CELLS (BOARD_WIDTH * BOARD_HEIGHT)
+
+
+/** Lane words: one 64-bit word, or four in an AVX2 register */
+#ifdef __AVX2__
+typedef uint64_t lanes_t __attribute__((vector_size(32)));
+#define LANE_WORDS 4
+#define LANE_WORD(lanes, w) ((lanes)[w])
+#else
+typedef uint64_t lanes_t;
+#define LANE_WORDS 1
+#define LANE_WORD(lanes, w) (*((void) (w), &(lanes)))
+#endif
+#define BATCH_GAMES (64 * LANE_WORDS)
+
+
+/** Batches played for each measurement */
+#define BATCHES (262144 / BATCH_GAMES)
+
+
+/** Bits in each bit-sliced ship health counter */
+#if BOARD_WIDTH < 8 && BOARD_HEIGHT < 8
+#define HEALTH_BITS 3
+#else
+#define HEALTH_BITS 7
+#endif
+
+
+/** Fleet being simulated */
+static const uint8_t fleet[NUM_SHIPS] = SHIP_LENGTHS;
+
+
+/** Bit-sliced state of BATCH_GAMES games, one lane per game */
+typedef struct batch {
+    lanes_t ship[NUM_SHIPS][CELLS];     //Lanes with ship s on cell c
+    lanes_t damage[CELLS];              //Lanes whose ship on cell c has been struck
+    lanes_t health[NUM_SHIPS][HEALTH_BITS]; //Unstruck cells of each ship, bit-sliced
+    lanes_t afloat[NUM_SHIPS];          //Lanes where ship s is not yet sunk
+    lanes_t target[CELLS];              //Attacker's target board: lanes that hit cell c
+    lanes_t sunk_count[HEALTH_BITS];    //Attacker's count of ships sunk, bit-sliced
+} Batch;
+
+
+/**
+Check whether any lane is set
+@param lanes lanes to test
+@return TRUE (1) if any lane is set, FALSE (0) otherwise
+*/
+static inline bool lanes_any(lanes_t lanes)
+{
+    uint64_t any = 0;
+    int w;
+    for (w = 0; w < LANE_WORDS; w++) {
+        any |= LANE_WORD(lanes, w);
+    }
+    return any != 0;
+}
+
+
+/**
+Load the fleets of BATCH_GAMES boards into a batch, one lane each
+@param batch batch to fill
+@param boards boards holding complete fleets
+*/
+static void batch_load(Batch* batch, Board* boards)
+{
+    int g, s, x, y, b;
+
+    memset(batch, 0, sizeof(*batch));
+    for (g = 0; g < BATCH_GAMES; g++) {
+        for (x = 0; x < BOARD_WIDTH; x++) {
+            //Visit only the ship cells of each column
+            board_col_t col = boards[g].boards[THIS_BOARD][x];
+            while (col) {
+                y = __builtin_ctzll(col);
+                s = boards[g].ship_at[x][y];
+                LANE_WORD(batch->ship[s][y * BOARD_WIDTH + x], g / 64) |= (uint64_t) 1 << (g % 64);
+                col &= col - 1;
+            }
+        }
+    }
+    for (s = 0; s < NUM_SHIPS; s++) {
+        batch->afloat[s] = ~batch->afloat[s];
+        for (b = 0; b < HEALTH_BITS; b++) {
+            if (fleet[s] & BIT(b)) {
+                batch->health[s][b] = ~batch->health[s][b];
+            }
+        }
+    }
+}
+
+
+/**
+Strike cell c in every game of a batch, as is_hit does for one board
+@param batch batch to operate on
+@param c cell struck
+@param sunk set to the lanes where the strike sank a ship
+@return lanes where the strike hit a ship
+*/
+static inline lanes_t batch_is_hit(Batch* batch, uint8_t c, lanes_t* sunk)
+{
+    lanes_t hit = batch->ship[0][c] & 0;
+    int s, b;
+
+    *sunk = hit;
+    for (s = 0; s < NUM_SHIPS; s++) {
+        lanes_t fresh = batch->ship[s][c] & ~batch->damage[c];
+        lanes_t borrow = fresh;
+        lanes_t left = hit;
+
+        //Subtract one from the health of the struck lanes
+        for (b = 0; b < HEALTH_BITS; b++) {
+            lanes_t bit = batch->health[s][b];
+            batch->health[s][b] = bit ^ borrow;
+            borrow &= ~bit;
+            left |= batch->health[s][b];
+        }
+        *sunk |= fresh & ~left;
+        batch->afloat[s] &= ~(fresh & ~left);
+        hit |= batch->ship[s][c];
+    }
+    batch->damage[c] |= hit;
+    return hit;
+}
+
+
+/**
+Record hits on the attacker's target board, counting ships sunk, as
+add_hit does for one board
+@param batch batch to operate on
+@param c cell struck
+@param hit lanes where the strike hit
+@param sunk lanes where the strike sank a ship
+*/
+static inline void batch_add_hit(Batch* batch, uint8_t c, lanes_t hit, lanes_t sunk)
+{
+    lanes_t carry = sunk;
+    int b;
+
+    batch->target[c] |= hit;
+    for (b = 0; b < HEALTH_BITS; b++) {
+        lanes_t bit = batch->sunk_count[b];
+        batch->sunk_count[b] = bit ^ carry;
+        carry &= bit;
+    }
+}
+
+
+/**
+Find the games won, as is_winner does for one board
+@param batch batch to operate on
+@return lanes whose attacker has sunk every ship
+*/
+static inline lanes_t batch_is_winner(Batch* batch)
+{
+    lanes_t afloat = batch->afloat[0];
+    int s;
+    for (s = 1; s < NUM_SHIPS; s++) {
+        afloat |= batch->afloat[s];
+    }
+    return ~afloat;
+}
+
+
+/**
+Play a batch of games to the end with a shared strike order
+@param batch batch holding the fleets
+@param order strike order
+@param shots set to the shots each game took to win
+*/
+static void batch_play(Batch* batch, const uint8_t* order, uint8_t* shots)
+{
+    lanes_t done = batch->afloat[0] & 0;
+    int t, w;
+
+    for (t = 0; t < CELLS; t++) {
+        lanes_t sunk;
+        lanes_t hit = batch_is_hit(batch, order[t], &sunk);
+        lanes_t won;
+        batch_add_hit(batch, order[t], hit, sunk);
+        won = batch_is_winner(batch) & ~done;
+        if (lanes_any(won)) {
+            for (w = 0; w < LANE_WORDS; w++) {
+                uint64_t bits = LANE_WORD(won, w);
+                while (bits) {
+                    shots[w * 64 + __builtin_ctzll(bits)] = t + 1;
+                    bits &= bits - 1;
+                }
+            }
+            done |= won;
+            if (!lanes_any(~done)) {
+                return;
+            }
+        }
+    }
+}
+
+
+/**
+Play one game with board.c, one strike at a time
+@param board board holding the fleet (struck in place)
+@param order strike order
+@return shots taken to sink the whole fleet
+*/
+static uint8_t scalar_play(Board* board, const uint8_t* order)
+{
+    uint8_t t;
+    for (t = 0; t < CELLS; t++) {
+        tinygl_point_t pos = tinygl_point(order[t] % BOARD_WIDTH, order[t] / BOARD_WIDTH);
+        if (is_hit(board, pos) == FLEET_SUNK) {
+            return t + 1;
+        }
+    }
+    return CELLS;
+}
+
+
+int main(void)
+{
+    static Board fleets[BATCHES][BATCH_GAMES];
+    static uint8_t orders[BATCHES][CELLS];
+    static uint8_t shots[BATCHES][BATCH_GAMES];
+    static uint8_t scalar_shots[BATCHES][BATCH_GAMES];
+    static Batch batches[BATCHES];
+    uint32_t rng = 1;
+    double start, scalar, load, play;
+    long games = (long) BATCHES * BATCH_GAMES;
+    long total = 0;
+    int n, g, i;
+
+    for (n = 0; n < BATCHES; n++) {
+        for (g = 0; g < BATCH_GAMES; g++) {
+            board_init(&fleets[n][g]);
+            auto_place(&fleets[n][g], &rng);
+        }
+        for (i = 0; i < CELLS; i++) {
+            orders[n][i] = i;
+        }
+        for (i = CELLS - 1; i > 0; i--) {
+            int j = random_next(&rng) % (i + 1);
+            uint8_t swap = orders[n][i];
+            orders[n][i] = orders[n][j];
+            orders[n][j] = swap;
+        }
+    }
+
+    start = bench_seconds();
+    for (n = 0; n < BATCHES; n++) {
+        batch_load(&batches[n], fleets[n]);
+    }
+    load = bench_seconds() - start;
+
+    start = bench_seconds();
+    for (n = 0; n < BATCHES; n++) {
+        batch_play(&batches[n], orders[n], shots[n]);
+    }
+    play = bench_seconds() - start;
+
+    //The scalar games strike the boards, so they go last
+    start = bench_seconds();
+    for (n = 0; n < BATCHES; n++) {
+        for (g = 0; g < BATCH_GAMES; g++) {
+            scalar_shots[n][g] = scalar_play(&fleets[n][g], orders[n]);
+        }
+    }
+    scalar = bench_seconds() - start;
+
+    for (n = 0; n < BATCHES; n++) {
+        for (g = 0; g < BATCH_GAMES; g++) {
+            if (scalar_shots[n][g] != shots[n][g]) {
+                printf("mismatch in batch %d game %d: %d shots, board.c %d\n",
+                       n, g, shots[n][g], scalar_shots[n][g]);
+                return 1;
+            }
+            total += shots[n][g];
+        }
+    }
+
+    printf("games checked: %ld, bit-sliced shots to win agree with board.c (avg %5.2f)\n",
+           games, (double) total / games);
+    printf("games/s  board.c %10.0f  bit-sliced %10.0f, %10.0f with loading  (%d lanes%s)\n",
+           games / scalar, games / play, games / (load + play),
+           BATCH_GAMES, LANE_WORDS > 1 ? ", AVX2" : "");
+    return 0;
+}
@@ -0,0 +1,197 @@
+/**
+@file       bench_board.c
+@authors    Jordan Griffiths (jlg108) & Jonty Trombik (jat157)
+@date       17 October 2026
+
+@brief      Host benchmark of ship validation and placement. Compares the
+            column mask checks in board.c with the per-cell loops they
+            replaced, over every placement of every ship on random boards.
+**/
+
+#include "bench.h"
+#include "board.h"
+
+
+/** Random boards to test placements against */
+#define NUM_BOARDS 256
+
+
+/** Timed passes over every board and placement */
+#define PASSES 200
+
+
+/**
+Per-cell validation, as before the column masks
+@param board board state to operate on.
+@return TRUE (1) if position is valid, FALSE (0) otherwise.
+*/
+static bool loop_is_valid_position(Board* board)
+{
+    Ship* ship = &board->cur_ship;
+    uint8_t i;
+    for (i = 0; i < ship->length; i++) {
+        uint8_t x_offset = ship->rot == HORIZ ? i : 0;
+        uint8_t y_offset = ship->rot == VERT ? i : 0;
+        if (board->boards[THIS_BOARD][ship->pos.x + x_offset] & COL_BIT(ship->pos.y + y_offset)) {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+
+/**
+Per-cell placement, as before the column masks
+@param board board state to operate on.
+@return TRUE (1) if ship placement was successful, FALSE (0) otherwise.
+*/
+static bool loop_place_ship(Board* board)
+{
+    Ship* ship = &board->cur_ship;
+    uint8_t i;
+    if (!loop_is_valid_position(board)) {
+        return FALSE;
+    }
+    for (i = 0; i < ship->length; i++) {
+        if (ship->rot == HORIZ) {
+            board->boards[THIS_BOARD][ship->pos.x + i] |= COL_BIT(ship->pos.y);
+        } else {
+            board->boards[THIS_BOARD][ship->pos.x] |= COL_BIT(ship->pos.y + i);
+        }
+    }
+    return TRUE;
+}
+
+
+/** Every on-board placement of every ship length */
+static uint8_t num_placements;
+static Ship placements[2 * BOARD_WIDTH * BOARD_HEIGHT * NUM_SHIPS];
+
+
+/**
+List every on-board placement of every ship in the fleet, masks included
+*/
+static void list_placements(void)
+{
+    static const uint8_t lengths[NUM_SHIPS] = SHIP_LENGTHS;
+    Board board;
+    uint8_t s, rot, x, y;
+
+    board_init(&board);
+    for (s = 0; s < NUM_SHIPS; s++) {
+        for (rot = HORIZ; rot <= VERT; rot++) {
+            for (x = 0; x < BOARD_WIDTH; x++) {
+                for (y = 0; y < BOARD_HEIGHT; y++) {
+                    if ((rot == HORIZ && x + lengths[s] > BOARD_WIDTH)
+                        || (rot == VERT && y + lengths[s] > BOARD_HEIGHT)) {
+                        continue;
+                    }
+                    reset_cur_ship(&board, lengths[s]);
+                    board.cur_ship.rot = rot;
+                    board.cur_ship.pos = tinygl_point(x, y);
+                    update_ship_mask(&board);
+                    placements[num_placements++] = board.cur_ship;
+                }
+            }
+        }
+    }
+}
+
+
+/**
+Time one validation routine over every board and placement
+@param boards boards to test against
+@param check validation routine
+@param remask TRUE to recompute the ship mask before each check, as a move does
+@return nanoseconds per check
+*/
+static double time_checks(Board* boards, bool (*check)(Board*), bool remask)
+{
+    double start = bench_seconds();
+    unsigned long valid = 0;
+    int pass, b, p;
+
+    for (pass = 0; pass < PASSES; pass++) {
+        for (b = 0; b < NUM_BOARDS; b++) {
+            for (p = 0; p < num_placements; p++) {
+                boards[b].cur_ship = placements[p];
+                if (remask) {
+                    update_ship_mask(&boards[b]);
+                }
+                valid += check(&boards[b]);
+            }
+        }
+    }
+    bench_sink += valid;
+    return (bench_seconds() - start) * 1e9 / ((double) PASSES * NUM_BOARDS * num_placements);
+}
+
+
+/**
+Time one placement routine over every board and placement
+@param boards boards to place on (restored after each placement)
+@param place placement routine
+@return nanoseconds per placement
+*/
+static double time_places(Board* boards, bool (*place)(Board*))
+{
+    double start = bench_seconds();
+    board_col_t saved[BOARD_WIDTH];
+    int pass, b, p;
+
+    for (pass = 0; pass < PASSES; pass++) {
+        for (b = 0; b < NUM_BOARDS; b++) {
+            Board* board = &boards[b];
+            memcpy(saved, board->boards[THIS_BOARD], sizeof(saved));
+            for (p = 0; p < num_placements; p++) {
+                board->cur_ship = placements[p];
+                board->cur_ship_num = 0;
+                if (place(board)) {
+                    memcpy(board->boards[THIS_BOARD], saved, sizeof(saved));
+                }
+            }
+            bench_sink += board->boards[THIS_BOARD][0];
+        }
+    }
+    return (bench_seconds() - start) * 1e9 / ((double) PASSES * NUM_BOARDS * num_placements);
+}
+
+
+int main(void)
+{
+    static Board boards[NUM_BOARDS];
+    uint32_t rng = 1;
+    int b, p;
+
+    list_placements();
+
+    //Boards holding the first ships of a random fleet, as during PLACING
+    for (b = 0; b < NUM_BOARDS; b++) {
+        board_init(&boards[b]);
+        auto_place(&boards[b], &rng);
+        if (b % 2) {
+            boards[b].boards[THIS_BOARD][random_next(&rng) % BOARD_WIDTH] = 0;
+        }
+    }
+
+    for (b = 0; b < NUM_BOARDS; b++) {
+        for (p = 0; p < num_placements; p++) {
+            boards[b].cur_ship = placements[p];
+            if (is_valid_position(&boards[b]) != loop_is_valid_position(&boards[b])) {
+                printf("mismatch on board %d placement %d\n", b, p);
+                return 1;
+            }
+        }
+    }
+    printf("placements checked: %d on %d boards, masks agree with loops\n",
+           num_placements, NUM_BOARDS);
+
+    printf("is_valid_position  loop %5.1f ns  mask %5.1f ns  mask+update %5.1f ns\n",
+           time_checks(boards, loop_is_valid_position, FALSE),
+           time_checks(boards, is_valid_position, FALSE),
+           time_checks(boards, is_valid_position, TRUE));
+    printf("place_ship         loop %5.1f ns  mask %5.1f ns\n",
+           time_places(boards, loop_place_ship),
+           time_places(boards, place_ship));
+    return 0;
+}
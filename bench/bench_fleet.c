@@ -0,0 +1,118 @@
+/**
+@file       bench_fleet.c
+@authors    Jordan Griffiths (jlg108) & Jonty Trombik (jat157)
+@date       17 October 2026
+
+@brief      Host benchmark of the random fleet generator. Times
+            auto_place() and checks that its fleets are uniform over every
+            legal ordered fleet, found by enumeration (see fleets.h).
+**/
+
+#include <math.h>
+#include "bench.h"
+#include "fleets.h"
+
+
+/** Fleets drawn for the uniformity check */
+#define DRAWS 20000000L
+
+
+/** Draws seen for each fleet key, and which keys are legal fleets */
+static uint32_t draws[FLEET_KEYS];
+static uint8_t legal[FLEET_KEYS];
+
+
+/**
+Key for the fleet placed on a board, read from its cell-to-ship index
+@param board board holding a complete fleet
+@return fleet key
+*/
+static long fleet_key(Board* board)
+{
+    long key = 0;
+    uint8_t s, x, y;
+    for (s = 0; s < NUM_SHIPS; s++) {
+        bool found = FALSE;
+        for (x = 0; x < BOARD_WIDTH && !found; x++) {
+            for (y = 0; y < BOARD_HEIGHT && !found; y++) {
+                if ((board->boards[THIS_BOARD][x] & COL_BIT(y)) && board->ship_at[x][y] == s) {
+                    //The first cell found is the left or top end of the ship
+                    bool vert = y + 1 < BOARD_HEIGHT
+                        && (board->boards[THIS_BOARD][x] & COL_BIT(y + 1))
+                        && board->ship_at[x][y + 1] == s;
+                    key |= (long) ship_key(vert ? VERT : HORIZ, x, y) << (SHIP_KEY_BITS * s);
+                    found = TRUE;
+                }
+            }
+        }
+    }
+    return key;
+}
+
+
+/**
+Mark a legal fleet found by the enumeration
+@param keys ship key of each ship
+@param weight fleets it stands for (always 1)
+@param context unused
+*/
+static void mark_legal(const uint8_t keys[NUM_SHIPS], uint8_t weight, void* context)
+{
+    (void) weight;
+    (void) context;
+    legal[fleet_key_of(keys)] = 1;
+}
+
+
+int main(void)
+{
+    static uint8_t reached[FLEET_KEYS];
+    Board board;
+    uint32_t rng = 1;
+    long fleets, draw, key, attempts = 0, reachable = 0;
+    double start, elapsed, chi_square = 0, expected;
+    uint32_t seed;
+
+    fleets = fleets_enumerate(FALSE, mark_legal, NULL);
+    printf("legal ordered fleets: %ld\n", fleets);
+
+    //Speed, counting the attempts each fleet takes
+    board_init(&board);
+    start = bench_seconds();
+    for (draw = 0; draw < DRAWS; draw++) {
+        do {
+            attempts++;
+        } while (!random_fleet_attempt(&board, &rng));
+        key = fleet_key(&board);
+        if (!legal[key]) {
+            printf("illegal fleet drawn\n");
+            return 1;
+        }
+        draws[key]++;
+    }
+    elapsed = bench_seconds() - start;
+    printf("auto_place     %9.0f fleets/s  (%.2f attempts per fleet, key lookup included)\n",
+           DRAWS / elapsed, (double) attempts / DRAWS);
+
+    //Pearson chi-square of the draws against a uniform distribution
+    expected = (double) DRAWS / fleets;
+    for (key = 0; key < FLEET_KEYS; key++) {
+        if (legal[key]) {
+            chi_square += (draws[key] - expected) * (draws[key] - expected) / expected;
+        }
+    }
+    printf("uniformity     chi-square %.0f over %ld degrees of freedom (z = %+.2f, %ld draws)\n",
+           chi_square, fleets - 1, (chi_square - (fleets - 1)) / sqrt(2.0 * (fleets - 1)), DRAWS);
+
+    //Fleets reachable from an odd 16-bit seed, as the device once seeded it
+    for (seed = 1; seed < 0x10000; seed += 2) {
+        rng = seed;
+        board_init(&board);
+        auto_place(&board, &rng);
+        key = fleet_key(&board);
+        reachable += !reached[key];
+        reached[key] = 1;
+    }
+    printf("odd 16-bit seeds reach %ld of %ld fleets\n", reachable, fleets);
+    return 0;
+}
@@ -0,0 +1,225 @@
+/**
+@file       bench_link.c
+@authors    Jordan Griffiths (jlg108) & Jonty Trombik (jat157)
+@date       17 October 2026
+
+@brief      Host benchmark of the IR link layer over a lossy channel. Two
+            copies of ir_link.c, renamed a_ and b_ by the Makefile, play
+            strike and reply exchanges at 2400 baud and the game's 300 Hz
+            loop rate while bytes are dropped or corrupted at random,
+            then again while each board in turn is reset between
+            exchanges. Fails if any exchange is lost or a reply is wrong.
+**/
+
+#include "bench.h"
+#include "ir_link.h"
+
+
+/** Game loop rate, and UART byte time in loop ticks (10 bits at 2400 baud is 1.25 ticks) */
+#define TICK_RATE 300
+#define BYTE_COST 5                     //Channel credit used per byte
+#define TICK_CREDIT 4                   //Channel credit gained per tick
+
+
+/** Exchanges run at each loss rate, and the tick limit for a run */
+#define EXCHANGES 2000
+#define MAX_TICKS 10000000L
+
+
+/** Exchanges between board resets in the reset runs, odd so the sequence bits are left mid-cycle */
+#define RESET_EXCHANGES 49
+
+
+/** Ticks with nothing on the channel before a board is reset, longer than a retry */
+#define QUIET_TICKS 40
+
+
+/** Bytes in flight on one direction of the channel */
+#define CHANNEL_SIZE 64
+
+
+/** Link functions of each board, as renamed by the Makefile */
+void a_ir_link_init(void);
+void a_ir_link_task(void);
+bool a_ir_link_send(uint8_t payload);
+uint8_t a_ir_link_receive(void);
+uint16_t a_ir_link_get_retries(void);
+void b_ir_link_init(void);
+void b_ir_link_task(void);
+bool b_ir_link_send(uint8_t payload);
+uint8_t b_ir_link_receive(void);
+uint16_t b_ir_link_get_retries(void);
+
+
+/** One direction of the IR channel */
+typedef struct channel {
+    uint8_t bytes[CHANNEL_SIZE];        //Bytes in flight, as a ring buffer
+    uint8_t head;                       //Next byte to arrive
+    uint8_t count;                      //Bytes in flight
+    uint8_t credit;                     //Sender's credit, spent at BYTE_COST per byte
+    long sent;                          //Bytes sent, whether or not they arrive
+} Channel;
+
+
+/** Channels from board a to b and from b to a */
+static Channel a_to_b, b_to_a;
+
+
+/** Chance of each byte being dropped or having one bit flipped */
+static double loss;
+
+
+/**
+Send a byte down a channel, maybe losing or corrupting it
+@param channel channel to send on
+@param byte byte to send
+*/
+static void channel_put(Channel* channel, uint8_t byte)
+{
+    channel->credit -= BYTE_COST;
+    channel->sent++;
+    if (rand() < loss * RAND_MAX) {
+        if (rand() & 1) {
+            return;
+        }
+        byte ^= 1 << (rand() % 8);
+    }
+    if (channel->count < CHANNEL_SIZE) {
+        channel->bytes[(channel->head + channel->count) % CHANNEL_SIZE] = byte;
+        channel->count++;
+    }
+}
+
+
+/**
+Take the next byte to arrive from a channel
+@param channel channel with a byte in flight
+@return received byte
+*/
+static uint8_t channel_get(Channel* channel)
+{
+    uint8_t byte = channel->bytes[channel->head];
+    channel->head = (channel->head + 1) % CHANNEL_SIZE;
+    channel->count--;
+    return byte;
+}
+
+
+/** IR UART of each board, as renamed by the Makefile */
+void a_ir_uart_init(void) {}
+void b_ir_uart_init(void) {}
+bool a_ir_uart_read_ready_p(void) { return b_to_a.count > 0; }
+bool b_ir_uart_read_ready_p(void) { return a_to_b.count > 0; }
+char a_ir_uart_getc(void) { return channel_get(&b_to_a); }
+char b_ir_uart_getc(void) { return channel_get(&a_to_b); }
+bool a_ir_uart_write_ready_p(void) { return a_to_b.credit >= BYTE_COST; }
+bool b_ir_uart_write_ready_p(void) { return b_to_a.credit >= BYTE_COST; }
+void a_ir_uart_putc(char ch) { channel_put(&a_to_b, ch); }
+void b_ir_uart_putc(char ch) { channel_put(&b_to_a, ch); }
+
+
+/**
+Run EXCHANGES round trips at one loss rate: board a sends a message,
+board b replies to it, and a checks the reply, as for a strike and its
+result. Prints the time taken, round trip times and retransmissions.
+@param rate chance of each byte being lost or corrupted
+@param resets TRUE (1) to reset a and b in turn every RESET_EXCHANGES
+exchanges, once the link has gone quiet
+@return TRUE (1) if every exchange completed with the right reply
+*/
+static bool run_exchanges(double rate, bool resets)
+{
+    long tick = 0, sent_at = 0, total = 0, worst = 0;
+    long traffic = 0;
+    int sent = 0, replies = 0, errors = 0, reset_count = 0, quiet = 0;
+
+    loss = rate;
+    srand(1);
+    memset(&a_to_b, 0, sizeof(a_to_b));
+    memset(&b_to_a, 0, sizeof(b_to_a));
+    a_ir_link_init();
+    b_ir_link_init();
+
+    while (replies < EXCHANGES && tick < MAX_TICKS) {
+        uint8_t message;
+        tick++;
+        if (a_to_b.credit < BYTE_COST) {
+            a_to_b.credit += TICK_CREDIT;
+        }
+        if (b_to_a.credit < BYTE_COST) {
+            b_to_a.credit += TICK_CREDIT;
+        }
+
+        quiet = a_to_b.sent + b_to_a.sent == traffic ? quiet + 1 : 0;
+        traffic = a_to_b.sent + b_to_a.sent;
+        if (resets && sent == replies && replies / RESET_EXCHANGES > reset_count) {
+            //Wait out retransmissions, so no message is lost with the reset board's state
+            if (quiet < QUIET_TICKS) {
+                a_ir_link_task();
+                b_ir_link_task();
+                continue;
+            }
+            if (reset_count++ & 1) {
+                b_ir_link_init();
+            } else {
+                a_ir_link_init();
+            }
+        }
+
+        if (sent == replies && sent < EXCHANGES) {
+            a_ir_link_send(sent & 0x3f);
+            sent_at = tick;
+            sent++;
+        }
+        a_ir_link_task();
+        b_ir_link_task();
+
+        message = b_ir_link_receive();
+        if (message != IR_LINK_EMPTY) {
+            b_ir_link_send(message | 0x40);
+        }
+        message = a_ir_link_receive();
+        if (message != IR_LINK_EMPTY) {
+            long rtt = tick - sent_at;
+            if (message != ((replies & 0x3f) | 0x40)) {
+                errors++;
+            }
+            total += rtt;
+            if (rtt > worst) {
+                worst = rtt;
+            }
+            replies++;
+        }
+    }
+
+    printf("loss %4.1f%%: %d exchanges in %.1f s, rtt avg %.1f ms max %.1f ms, errors %d, retries %u + %u",
+           rate * 100, replies, (double) tick / TICK_RATE,
+           replies > 0 ? total * 1000.0 / TICK_RATE / replies : 0.0,
+           worst * 1000.0 / TICK_RATE, errors,
+           a_ir_link_get_retries(), b_ir_link_get_retries());
+    if (resets) {
+        printf(", resets %d", reset_count);
+    }
+    printf("\n");
+    return replies == EXCHANGES && errors == 0;
+}
+
+
+int main(void)
+{
+    static const double rates[] = {0, 0.01, 0.05, 0.1, 0.2};
+    bool ok = 1;
+    uint8_t i;
+
+    for (i = 0; i < sizeof(rates) / sizeof(rates[0]); i++) {
+        ok &= run_exchanges(rates[i], 0);
+    }
+    for (i = 0; i < sizeof(rates) / sizeof(rates[0]); i++) {
+        ok &= run_exchanges(rates[i], 1);
+    }
+    if (!ok) {
+        printf("link lost or garbled an exchange\n");
+        return 1;
+    }
+    return 0;
+}
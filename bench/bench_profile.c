@@ -0,0 +1,96 @@
+/**
+@file       bench_profile.c
+@authors    Jordan Griffiths (jlg108) & Jonty Trombik (jat157)
+@date       17 October 2026
+
+@brief      Host benchmark of the profiler. Records random samples into
+            profile.c, checks its min/avg/max against a reference count,
+            times profile_record, then prints a report through the same
+            profile_dump routines the device sends over IR.
+**/
+
+#include "bench.h"
+#include "profile.h"
+
+
+/** Statistics recorded, and samples recorded into each */
+#define NUM_STATS 4
+#define SAMPLES 1000000L
+
+
+/** Samples are drawn from [0, MAX_TICKS << stat) */
+#define MAX_TICKS 512
+
+
+/**
+Next value of a xorshift32 generator
+@param state generator state, nonzero
+@return next value
+*/
+static uint32_t xorshift(uint32_t* state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+
+/**
+Print one character of a report
+@param c character to print
+*/
+static void put(char c)
+{
+    putchar(c);
+}
+
+
+int main(void)
+{
+    static timer_tick_t samples[NUM_STATS][SAMPLES];
+    ProfileStat stats[NUM_STATS];
+    uint16_t counts[NUM_STATS];
+    uint32_t rng = 1;
+    double start, elapsed;
+    long i;
+    int s;
+
+    for (s = 0; s < NUM_STATS; s++) {
+        for (i = 0; i < SAMPLES; i++) {
+            samples[s][i] = xorshift(&rng) % ((uint32_t) MAX_TICKS << s);
+        }
+    }
+
+    profile_reset(stats, NUM_STATS);
+    start = bench_seconds();
+    for (s = 0; s < NUM_STATS; s++) {
+        for (i = 0; i < SAMPLES; i++) {
+            profile_record(&stats[s], samples[s][i]);
+        }
+    }
+    elapsed = bench_seconds() - start;
+
+    for (s = 0; s < NUM_STATS; s++) {
+        uint16_t min = UINT16_MAX, max = 0;
+        uint64_t total = 0;
+        for (i = 0; i < SAMPLES; i++) {
+            min = samples[s][i] < min ? samples[s][i] : min;
+            max = samples[s][i] > max ? samples[s][i] : max;
+            total += samples[s][i];
+        }
+        if (stats[s].count != SAMPLES || stats[s].min != min || stats[s].max != max
+            || stats[s].total != total || profile_average(&stats[s]) != total * 100 / SAMPLES) {
+            printf("statistic %d disagrees with the reference count\n", s);
+            return 1;
+        }
+        counts[s] = max;
+    }
+
+    printf("samples checked: %ld, min/avg/max agree with a reference count\n", SAMPLES * NUM_STATS);
+    printf("profile_record %6.2f ns\n", elapsed * 1e9 / (SAMPLES * NUM_STATS));
+    profile_dump(put, "stat", stats, NUM_STATS);
+    profile_dump_value(put, "res", PROFILE_CYCLES_PER_TICK);
+    profile_dump_counts(put, "max", counts, NUM_STATS);
+    return 0;
+}
@@ -0,0 +1,181 @@
+/**
+@file       bench_target.c
+@authors    Jordan Griffiths (jlg108) & Jonty Trombik (jat157)
+@date       17 October 2026
+
+@brief      Host benchmark of the probability density targeting. Checks
+            the incremental counts against a full recount, times both, and
+            plays target_best() against random fleets to measure the
+            average number of shots needed to win.
+**/
+
+#include "bench.h"
+#include "target.h"
+
+
+/** Games played for each measurement */
+#define GAMES 20000
+
+
+/** Fleet being searched for */
+static const uint8_t fleet[NUM_SHIPS] = SHIP_LENGTHS;
+
+
+/**
+Recount every cell from scratch, the way the incremental update avoids
+@param target targeting state holding the strikes, blocked cells and
+afloat ships; counts are rewritten.
+*/
+static void full_recount(Targeter* target)
+{
+    uint8_t s, rot, x, y, i;
+
+    memset(target->counts, 0, sizeof(target->counts));
+    memset(target->hit_counts, 0, sizeof(target->hit_counts));
+    for (s = 0; s < NUM_SHIPS; s++) {
+        uint8_t len = fleet[s];
+        if (!(target->afloat & BIT(s))) {
+            continue;
+        }
+        for (rot = HORIZ; rot <= VERT; rot++) {
+            for (x = 0; x + (rot == HORIZ ? len - 1 : 0) < BOARD_WIDTH; x++) {
+                for (y = 0; y + (rot == VERT ? len - 1 : 0) < BOARD_HEIGHT; y++) {
+                    bool blocked = FALSE;
+                    bool hit = FALSE;
+                    for (i = 0; i < len; i++) {
+                        uint8_t cx = rot == HORIZ ? x + i : x;
+                        uint8_t cy = rot == VERT ? y + i : y;
+                        blocked |= (target->blocked[cx] & COL_BIT(cy)) != 0;
+                        hit |= (target->hits[cx] & COL_BIT(cy)) != 0;
+                    }
+                    if (blocked) {
+                        continue;
+                    }
+                    for (i = 0; i < len; i++) {
+                        uint8_t cx = rot == HORIZ ? x + i : x;
+                        uint8_t cy = rot == VERT ? y + i : y;
+                        target->counts[cx][cy]++;
+                        target->hit_counts[cx][cy] += hit;
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+/**
+Shuffle every cell of the board into a random strike order
+@param order strike order to fill
+@param rng random state to draw from.
+*/
+static void random_order(tinygl_point_t order[BOARD_WIDTH * BOARD_HEIGHT], uint32_t* rng)
+{
+    int i;
+    for (i = 0; i < BOARD_WIDTH * BOARD_HEIGHT; i++) {
+        order[i] = tinygl_point(i % BOARD_WIDTH, i / BOARD_WIDTH);
+    }
+    for (i = BOARD_WIDTH * BOARD_HEIGHT - 1; i > 0; i--) {
+        int j = random_next(rng) % (i + 1);
+        tinygl_point_t swap = order[i];
+        order[i] = order[j];
+        order[j] = swap;
+    }
+}
+
+
+/**
+Play one game against a random fleet
+@param rng random state to draw from.
+@param use_density TRUE to fire at target_best(), FALSE to fire in random order
+@return shots taken to sink the whole fleet
+*/
+static int play_game(uint32_t* rng, bool use_density)
+{
+    tinygl_point_t order[BOARD_WIDTH * BOARD_HEIGHT];
+    Board defender;
+    Targeter target;
+    int shots = 0;
+    strike_result_t result;
+
+    board_init(&defender);
+    auto_place(&defender, rng);
+    target_init(&target);
+    random_order(order, rng);
+    do {
+        tinygl_point_t pos = use_density ? target_best(&target) : order[shots];
+        result = is_hit(&defender, pos);
+        target_record(&target, pos, result);
+        shots++;
+    } while (result != FLEET_SUNK);
+    return shots;
+}
+
+
+int main(void)
+{
+    static tinygl_point_t orders[GAMES][BOARD_WIDTH * BOARD_HEIGHT];
+    static strike_result_t results[GAMES][BOARD_WIDTH * BOARD_HEIGHT];
+    Targeter target, recount;
+    Board defender;
+    uint32_t rng = 1;
+    double start, incremental, full;
+    long updates = (long) GAMES * BOARD_WIDTH * BOARD_HEIGHT;
+    long shots;
+    int game, i;
+
+    //Every strike of a game in random order, checked against a recount
+    for (game = 0; game < GAMES; game++) {
+        board_init(&defender);
+        auto_place(&defender, &rng);
+        random_order(orders[game], &rng);
+        target_init(&target);
+        for (i = 0; i < BOARD_WIDTH * BOARD_HEIGHT; i++) {
+            results[game][i] = is_hit(&defender, orders[game][i]);
+            target_record(&target, orders[game][i], results[game][i]);
+            recount = target;
+            full_recount(&recount);
+            if (memcmp(&recount, &target, sizeof(Targeter)) != 0) {
+                printf("mismatch in game %d after %d strikes\n", game, i + 1);
+                return 1;
+            }
+        }
+    }
+    printf("updates checked: %ld, incremental counts agree with a full recount\n", updates);
+
+    //Replay the same games, timing each way of keeping the counts
+    start = bench_seconds();
+    for (game = 0; game < GAMES; game++) {
+        target_init(&target);
+        for (i = 0; i < BOARD_WIDTH * BOARD_HEIGHT; i++) {
+            target_record(&target, orders[game][i], results[game][i]);
+        }
+        bench_sink += target.counts[0][0];
+    }
+    incremental = bench_seconds() - start;
+
+    //The recount reuses target_record's bitmaps, so its time includes the update
+    start = bench_seconds();
+    for (game = 0; game < GAMES; game++) {
+        target_init(&target);
+        for (i = 0; i < BOARD_WIDTH * BOARD_HEIGHT; i++) {
+            target_record(&target, orders[game][i], results[game][i]);
+            full_recount(&target);
+        }
+        bench_sink += target.counts[0][0];
+    }
+    full = bench_seconds() - start;
+
+    printf("target_record  %9.0f updates/s  (full recount %9.0f updates/s)\n",
+           updates / incremental, updates / full);
+
+    for (i = 0; i < 2; i++) {
+        shots = 0;
+        for (game = 0; game < GAMES; game++) {
+            shots += play_game(&rng, i == 0);
+        }
+        printf("shots to win   %5.2f  (%s, %d random fleets)\n",
+               (double) shots / GAMES, i == 0 ? "target_best" : "random order", GAMES);
+    }
+    return 0;
+}
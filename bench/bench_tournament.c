@@ -0,0 +1,513 @@
+/**
+@file       bench_tournament.c
+@authors    Jordan Griffiths (jlg108) & Jonty Trombik (jat157)
+@date       17 October 2026
+
+@brief      Host self-play tournament between strike strategies. Plays
+            complete games under the board.c rules, spread over every
+            core by a work-stealing scheduler, and reports games per
+            second and a shots-to-win histogram for each strategy. Each
+            game draws its fleet and strikes from a state derived from
+            the seed and the game's index alone, and results are summed
+            per thread, so a given seed gives the same results whatever
+            the thread count. The density strategy is also played through
+            a transposition cache shared by every thread (see tcache.h),
+            whose hit rate is reported.
+
+            Usage: bench_tournament [games [seed [threads]]]
+**/
+
+#include <pthread.h>
+#include <unistd.h>
+#include "bench.h"
+#include "target.h"
+#include "tcache.h"
+
+
+/** Defaults for the command line arguments */
+#define DEFAULT_GAMES 200000L
+#define DEFAULT_SEED 1
+
+
+/** Games in one unit of scheduled work */
+#define BATCH_GAMES 256
+
+
+/** Games replayed on one thread and on all threads to check reproducibility */
+#define CHECK_GAMES 20000L
+
+
+/** Most threads the scheduler will run */
+#define MAX_THREADS 64
+
+
+/** Cells on the board, the most shots a game can take */
+#define CELLS (BOARD_WIDTH * BOARD_HEIGHT)
+
+
+/** Width of the longest histogram bar */
+#define BAR_WIDTH 40
+
+
+/** log2 of the transposition cache slots */
+#define TCACHE_BITS 16
+
+
+/** State of the player firing at a random fleet */
+typedef struct shooter {
+    Targeter target;                    //Strikes so far, with density counts for those that use them
+    tinygl_point_t order[CELLS];        //Every cell in a random strike order
+    uint8_t next;                       //Next entry of order to consider
+    uint32_t lookups;                   //Transposition cache probes this game
+    uint32_t hits;                      //...that found their state
+} Shooter;
+
+
+/** Strike strategy under test */
+typedef struct strategy {
+    const char* name;
+    tinygl_point_t (*choose)(Shooter* shooter); //Pick the next cell to strike
+} Strategy;
+
+
+/** Shots-to-win histogram, indexed by shots taken */
+typedef struct tally {
+    unsigned long games[CELLS + 1];
+} Tally;
+
+
+/** Work queue of one thread: batches [lo, hi) not yet played */
+typedef struct worker {
+    pthread_mutex_t lock;
+    long lo;
+    long hi;
+    Tally tally;                        //Results of the batches this thread played
+    pthread_t thread;
+} Worker;
+
+
+/** One run of a strategy over many games */
+typedef struct run {
+    const Strategy* strategy;
+    uint32_t seed;
+    long games;
+    int num_workers;
+    Worker workers[MAX_THREADS];
+} Run;
+
+
+/**
+Check whether a cell has been struck
+@param shooter player state
+@param pos cell to check
+@return TRUE (1) if struck, FALSE (0) otherwise
+*/
+static bool is_struck(Shooter* shooter, tinygl_point_t pos)
+{
+    return ((shooter->target.hits[pos.x] | shooter->target.blocked[pos.x]) & COL_BIT(pos.y)) != 0;
+}
+
+
+/**
+Take the next unstruck cell of the random order, optionally only from
+one colour of a checkerboard
+@param shooter player state
+@param parity TRUE to skip cells whose x + y is odd
+@return cell to strike, or the first unstruck cell if parity leaves none
+*/
+static tinygl_point_t next_in_order(Shooter* shooter, bool parity)
+{
+    uint8_t i;
+    for (i = shooter->next; i < CELLS; i++) {
+        tinygl_point_t pos = shooter->order[i];
+        if (!is_struck(shooter, pos) && (!parity || (pos.x + pos.y) % 2 == 0)) {
+            if (!parity) {
+                shooter->next = i + 1;
+            }
+            return pos;
+        }
+    }
+    for (i = 0; i < CELLS; i++) {
+        if (!is_struck(shooter, shooter->order[i])) {
+            return shooter->order[i];
+        }
+    }
+    return shooter->order[0];
+}
+
+
+/**
+Random strategy: strike every cell in a random order
+@param shooter player state
+@return cell to strike
+*/
+static tinygl_point_t choose_random(Shooter* shooter)
+{
+    return next_in_order(shooter, FALSE);
+}
+
+
+/**
+Hunt and target strategy: strike next to a hit on a ship not yet sunk,
+otherwise hunt over one colour of a checkerboard in random order
+@param shooter player state
+@return cell to strike
+*/
+static tinygl_point_t choose_hunt(Shooter* shooter)
+{
+    static const int8_t dx[4] = {0, 1, 0, -1};
+    static const int8_t dy[4] = {-1, 0, 1, 0};
+    uint8_t x, y, d;
+
+    for (x = 0; x < BOARD_WIDTH; x++) {
+        board_col_t open_hits = shooter->target.hits[x] & ~shooter->target.blocked[x];
+        for (y = 0; open_hits && y < BOARD_HEIGHT; y++) {
+            if (!(open_hits & COL_BIT(y))) {
+                continue;
+            }
+            for (d = 0; d < 4; d++) {
+                int8_t nx = x + dx[d];
+                int8_t ny = y + dy[d];
+                if (nx >= 0 && nx < BOARD_WIDTH && ny >= 0 && ny < BOARD_HEIGHT
+                    && !is_struck(shooter, tinygl_point(nx, ny))) {
+                    return tinygl_point(nx, ny);
+                }
+            }
+        }
+    }
+    return next_in_order(shooter, TRUE);
+}
+
+
+/**
+Density strategy: strike the best cell by placement counts (see target.c)
+@param shooter player state
+@return cell to strike
+*/
+static tinygl_point_t choose_density(Shooter* shooter)
+{
+    return target_best(&shooter->target);
+}
+
+
+/** Transposition cache shared by every thread */
+static TCache cache;
+
+
+/**
+Density strategy through the transposition cache: the same cell as
+choose_density, looked up by target board state when another game has
+already reached it
+@param shooter player state
+@return cell to strike
+*/
+static tinygl_point_t choose_cached(Shooter* shooter)
+{
+    TCacheKey key;
+    TCacheValue value;
+
+    tcache_key(&shooter->target, &key);
+    shooter->lookups++;
+    if (tcache_probe(&cache, &key, &value)) {
+        shooter->hits++;
+        return value.best;
+    }
+    value.best = target_best(&shooter->target);
+    value.score = target_score(&shooter->target, value.best.x, value.best.y);
+    tcache_store(&cache, &key, &value);
+    return value.best;
+}
+
+
+/** Strategies in the tournament */
+static const Strategy strategies[] = {
+    {"random", choose_random},
+    {"hunt", choose_hunt},
+    {"density", choose_density},
+    {"cached", choose_cached},
+};
+#define NUM_STRATEGIES (sizeof(strategies) / sizeof(strategies[0]))
+
+
+/**
+Random state for one game, mixed from the seed and the game's index
+@param seed tournament seed
+@param game index of game
+@return non-zero xorshift state
+*/
+static uint32_t game_state(uint32_t seed, long game)
+{
+    uint32_t z = seed + 0x9e3779b9u * (uint32_t) (game + 1);
+    z = (z ^ (z >> 16)) * 0x85ebca6bu;
+    z = (z ^ (z >> 13)) * 0xc2b2ae35u;
+    z ^= z >> 16;
+    return z ? z : 1;
+}
+
+
+/**
+Play one game of a strategy against a random fleet
+@param strategy strategy firing
+@param seed tournament seed
+@param game index of game
+@return shots taken to sink the whole fleet
+*/
+static int play_game(const Strategy* strategy, uint32_t seed, long game)
+{
+    uint32_t rng = game_state(seed, game);
+    Shooter shooter;
+    Board defender;
+    strike_result_t result;
+    int shots = 0;
+    int i;
+
+    board_init(&defender);
+    auto_place(&defender, &rng);
+    target_init(&shooter.target);
+    for (i = 0; i < CELLS; i++) {
+        shooter.order[i] = tinygl_point(i % BOARD_WIDTH, i / BOARD_WIDTH);
+    }
+    for (i = CELLS - 1; i > 0; i--) {
+        int j = random_next(&rng) % (i + 1);
+        tinygl_point_t swap = shooter.order[i];
+        shooter.order[i] = shooter.order[j];
+        shooter.order[j] = swap;
+    }
+    shooter.next = 0;
+    shooter.lookups = 0;
+    shooter.hits = 0;
+
+    do {
+        tinygl_point_t pos = strategy->choose(&shooter);
+        result = is_hit(&defender, pos);
+        target_record(&shooter.target, pos, result);
+        shots++;
+    } while (result != FLEET_SUNK && shots < CELLS);
+
+    if (shooter.lookups > 0) {
+        tcache_count(&cache, shooter.lookups, shooter.hits);
+    }
+    return shots;
+}
+
+
+/**
+Take a batch for a worker: its own next batch if it has one, otherwise
+the back half of the largest queue of another worker
+@param run run in progress
+@param self index of the worker
+@return index of batch, or -1 once no work is left anywhere
+*/
+static long take_batch(Run* run, int self)
+{
+    Worker* me = &run->workers[self];
+    long batch = -1;
+    int w;
+
+    pthread_mutex_lock(&me->lock);
+    if (me->lo < me->hi) {
+        batch = me->lo++;
+    }
+    pthread_mutex_unlock(&me->lock);
+
+    while (batch < 0) {
+        Worker* victim = NULL;
+        long most = 0;
+        long lo = 0, hi = 0;
+        for (w = 0; w < run->num_workers; w++) {
+            long left;
+            if (w == self) {
+                continue;
+            }
+            pthread_mutex_lock(&run->workers[w].lock);
+            left = run->workers[w].hi - run->workers[w].lo;
+            pthread_mutex_unlock(&run->workers[w].lock);
+            if (left > most) {
+                most = left;
+                victim = &run->workers[w];
+            }
+        }
+        if (victim == NULL) {
+            return -1;
+        }
+
+        //Only one lock is held at a time, so two thieves cannot deadlock
+        pthread_mutex_lock(&victim->lock);
+        if (victim->lo < victim->hi) {
+            lo = victim->hi - (victim->hi - victim->lo + 1) / 2;
+            hi = victim->hi;
+            victim->hi = lo;
+        }
+        pthread_mutex_unlock(&victim->lock);
+
+        if (lo < hi) {
+            pthread_mutex_lock(&me->lock);
+            me->lo = lo + 1;
+            me->hi = hi;
+            pthread_mutex_unlock(&me->lock);
+            batch = lo;
+        }
+    }
+    return batch;
+}
+
+
+/** Arguments of one worker thread */
+typedef struct worker_arg {
+    Run* run;
+    int self;
+} WorkerArg;
+
+
+/**
+Worker thread: play batches until none are left anywhere
+@param arg worker arguments (WorkerArg)
+@return NULL
+*/
+static void* worker_main(void* arg)
+{
+    Run* run = ((WorkerArg*) arg)->run;
+    int self = ((WorkerArg*) arg)->self;
+    Tally* tally = &run->workers[self].tally;
+    long batch, game;
+
+    while ((batch = take_batch(run, self)) >= 0) {
+        long end = (batch + 1) * BATCH_GAMES;
+        for (game = batch * BATCH_GAMES; game < end && game < run->games; game++) {
+            tally->games[play_game(run->strategy, run->seed, game)]++;
+        }
+    }
+    return NULL;
+}
+
+
+/**
+Play games of one strategy on a number of threads
+@param strategy strategy firing
+@param seed tournament seed
+@param games number of games
+@param threads number of threads
+@param tally histogram to fill
+@return seconds taken
+*/
+static double run_games(const Strategy* strategy, uint32_t seed, long games, int threads, Tally* tally)
+{
+    static Run run;
+    WorkerArg args[MAX_THREADS];
+    long batches = (games + BATCH_GAMES - 1) / BATCH_GAMES;
+    double start = bench_seconds();
+    int w, i;
+
+    run.strategy = strategy;
+    run.seed = seed;
+    run.games = games;
+    run.num_workers = threads;
+    for (w = 0; w < threads; w++) {
+        Worker* worker = &run.workers[w];
+        pthread_mutex_init(&worker->lock, NULL);
+        worker->lo = batches * w / threads;
+        worker->hi = batches * (w + 1) / threads;
+        memset(&worker->tally, 0, sizeof(worker->tally));
+        args[w].run = &run;
+        args[w].self = w;
+        pthread_create(&worker->thread, NULL, worker_main, &args[w]);
+    }
+
+    memset(tally, 0, sizeof(*tally));
+    for (w = 0; w < threads; w++) {
+        pthread_join(run.workers[w].thread, NULL);
+        pthread_mutex_destroy(&run.workers[w].lock);
+        for (i = 0; i <= CELLS; i++) {
+            tally->games[i] += run.workers[w].tally.games[i];
+        }
+    }
+    return bench_seconds() - start;
+}
+
+
+/**
+Print a strategy's results: throughput, summary and histogram
+@param strategy strategy played
+@param tally its histogram
+@param games number of games
+@param seconds time taken
+*/
+static void print_tally(const Strategy* strategy, Tally* tally, long games, double seconds)
+{
+    unsigned long most = 0;
+    double total = 0;
+    long seen = 0;
+    int median = 0, low = 0, high = 0;
+    int i, j;
+
+    for (i = 0; i <= CELLS; i++) {
+        if (tally->games[i] > most) {
+            most = tally->games[i];
+        }
+        if (tally->games[i] > 0) {
+            low = low ? low : i;
+            high = i;
+        }
+        total += (double) i * tally->games[i];
+        seen += tally->games[i];
+        if (!median && seen * 2 >= games) {
+            median = i;
+        }
+    }
+
+    printf("%-8s %9.0f games/s  shots to win avg %5.2f  median %d  min %d  max %d\n",
+           strategy->name, games / seconds, total / games, median, low, high);
+    for (i = low; i <= high; i++) {
+        printf("  %2d %9lu ", i, tally->games[i]);
+        for (j = 0; j < (int) (tally->games[i] * BAR_WIDTH / most); j++) {
+            putchar('#');
+        }
+        putchar('\n');
+    }
+}
+
+
+int main(int argc, char** argv)
+{
+    long games = argc > 1 ? atol(argv[1]) : DEFAULT_GAMES;
+    uint32_t seed = argc > 2 ? strtoul(argv[2], NULL, 0) : DEFAULT_SEED;
+    int threads = argc > 3 ? atoi(argv[3]) : sysconf(_SC_NPROCESSORS_ONLN);
+    long check = games < CHECK_GAMES ? games : CHECK_GAMES;
+    Tally tally, single;
+    unsigned int s;
+
+    if (games < 1 || threads < 1 || threads > MAX_THREADS) {
+        fprintf(stderr, "usage: %s [games [seed [threads (1 to %d)]]]\n", argv[0], MAX_THREADS);
+        return 1;
+    }
+    if (!tcache_init(&cache, TCACHE_BITS)) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    //Results may depend on the seed but never on the thread count
+    for (s = 0; s < NUM_STRATEGIES; s++) {
+        run_games(&strategies[s], seed, check, 1, &single);
+        run_games(&strategies[s], seed, check, threads > 1 ? threads : 4, &tally);
+        if (memcmp(&single, &tally, sizeof(Tally)) != 0) {
+            printf("%s: results differ between thread counts\n", strategies[s].name);
+            return 1;
+        }
+    }
+    printf("tournament: %ld games per strategy, seed %lu, %d threads, "
+           "reproducible across thread counts\n", games, (unsigned long) seed, threads);
+
+    for (s = 0; s < NUM_STRATEGIES; s++) {
+        double seconds;
+        cache.lookups = cache.hits = cache.stores = 0;
+        seconds = run_games(&strategies[s], seed, games, threads, &tally);
+        print_tally(&strategies[s], &tally, games, seconds);
+        if (cache.lookups > 0) {
+            printf("  cache: %d slots, %llu lookups, hit rate %.1f%%, %llu stores\n",
+                   1 << TCACHE_BITS, (unsigned long long) cache.lookups,
+                   100.0 * cache.hits / cache.lookups, (unsigned long long) cache.stores);
+        }
+    }
+    tcache_free(&cache);
+    return 0;
+}
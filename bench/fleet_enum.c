@@ -0,0 +1,198 @@
+/**
+@file       fleet_enum.c
+@authors    Jordan Griffiths (jlg108) & Jonty Trombik (jat157)
+@date       17 October 2026
+
+@brief      Host tool that counts and writes out every legal ordered
+            fleet, as ground truth for exact probabilities. The search
+            covers one first ship placement per orbit under the board's
+            flips, and checks that expanding its fleets by those flips
+            gives exactly the fleets of a full search.
+
+            Usage: fleet_enum [file]
+
+            The file (default fleets.bin) is a FleetFileHeader followed by
+            records of record_size bytes: the ship key of each ship in
+            fleet order (see fleets.h), then the record's weight. A record
+            stands for its own fleet and for the images under the flips
+            that move its first ship to a different placement; weight is
+            the number of fleets it stands for. Header fields are
+            little-endian and naturally aligned, and records are bytes, so
+            the file can be memory-mapped and read in place.
+**/
+
+#include "bench.h"
+#include "fleets.h"
+
+
+/** Default output file */
+#define DEFAULT_FILE "fleets.bin"
+
+
+/** Record layout: one key byte per ship, then the weight */
+#define RECORD_SIZE (NUM_SHIPS + 1)
+
+
+/** File header, 24 bytes */
+typedef struct fleet_file_header {
+    char magic[4];                      //"FLT1"
+    uint8_t width;                      //BOARD_WIDTH
+    uint8_t height;                     //BOARD_HEIGHT
+    uint8_t num_ships;                  //NUM_SHIPS
+    uint8_t record_size;                //Bytes per record
+    uint8_t lengths[8];                 //SHIP_LENGTHS, zero padded
+    uint32_t fleets;                    //Legal ordered fleets, the sum of the record weights
+    uint32_t records;                   //Records following the header
+} FleetFileHeader;
+
+#if NUM_SHIPS > 8
+#error "FleetFileHeader holds at most 8 ship lengths"
+#endif
+
+
+/** Fleet being placed */
+static const uint8_t fleet[NUM_SHIPS] = SHIP_LENGTHS;
+
+
+/** Records found by the reduced search */
+typedef struct records {
+    uint8_t* data;
+    long count;
+    long capacity;
+} Records;
+
+
+/**
+Mark a fleet found by the full search as legal
+@param keys ship key of each ship
+@param weight fleets it stands for (always 1)
+@param context legal map, indexed by fleet key
+*/
+static void mark_legal(const uint8_t keys[NUM_SHIPS], uint8_t weight, void* context)
+{
+    (void) weight;
+    ((uint8_t*) context)[fleet_key_of(keys)] = 1;
+}
+
+
+/**
+Append a fleet found by the reduced search to the records
+@param keys ship key of each ship
+@param weight fleets it stands for
+@param context records
+*/
+static void add_record(const uint8_t keys[NUM_SHIPS], uint8_t weight, void* context)
+{
+    Records* records = context;
+    uint8_t* record;
+
+    if (records->count == records->capacity) {
+        records->capacity = records->capacity ? records->capacity * 2 : 1024;
+        records->data = realloc(records->data, records->capacity * RECORD_SIZE);
+        if (records->data == NULL) {
+            fprintf(stderr, "out of memory\n");
+            exit(1);
+        }
+    }
+    record = records->data + records->count * RECORD_SIZE;
+    memcpy(record, keys, NUM_SHIPS);
+    record[NUM_SHIPS] = weight;
+    records->count++;
+}
+
+
+/**
+Expand every record by its flips and check the result is exactly the
+legal fleets, each once
+@param records records of the reduced search
+@param legal legal map from the full search
+@param fleets number of legal fleets
+@return TRUE (1) if the expansion matches, FALSE (0) otherwise
+*/
+static bool check_records(Records* records, const uint8_t* legal, long fleets)
+{
+    static uint8_t reached[FLEET_KEYS];
+    long r, expanded = 0;
+    uint8_t flip, seen, s;
+
+    for (r = 0; r < records->count; r++) {
+        const uint8_t* record = records->data + r * RECORD_SIZE;
+        uint8_t weight = 0;
+        for (flip = 0; flip < NUM_FLIPS; flip++) {
+            uint8_t keys[NUM_SHIPS];
+            long key;
+            //Only flips that move the first ship somewhere new belong to this record
+            for (seen = 0; seen < flip && flip_ship_key(record[0], fleet[0], seen)
+                                          != flip_ship_key(record[0], fleet[0], flip); seen++) {
+                continue;
+            }
+            if (seen < flip) {
+                continue;
+            }
+            for (s = 0; s < NUM_SHIPS; s++) {
+                keys[s] = flip_ship_key(record[s], fleet[s], flip);
+            }
+            key = fleet_key_of(keys);
+            if (!legal[key] || reached[key]) {
+                return FALSE;
+            }
+            reached[key] = 1;
+            weight++;
+            expanded++;
+        }
+        if (weight != record[NUM_SHIPS]) {
+            return FALSE;
+        }
+    }
+    return expanded == fleets;
+}
+
+
+int main(int argc, char** argv)
+{
+    static uint8_t legal[FLEET_KEYS];
+    const char* path = argc > 1 ? argv[1] : DEFAULT_FILE;
+    Records records = {NULL, 0, 0};
+    FleetFileHeader header;
+    double start, full_time, reduced_time;
+    long full, reduced;
+    FILE* file;
+
+    start = bench_seconds();
+    full = fleets_enumerate(FALSE, mark_legal, legal);
+    full_time = bench_seconds() - start;
+
+    start = bench_seconds();
+    reduced = fleets_enumerate(TRUE, add_record, &records);
+    reduced_time = bench_seconds() - start;
+
+    if (reduced != full || !check_records(&records, legal, full)) {
+        printf("reduced search disagrees with the full search (%ld against %ld fleets)\n", reduced, full);
+        return 1;
+    }
+    printf("legal ordered fleets: %ld, %ld records after flips, agree with a full search\n",
+           full, records.count);
+    printf("search  full %7.2f ms  reduced %7.2f ms\n", full_time * 1e3, reduced_time * 1e3);
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, "FLT1", 4);
+    header.width = BOARD_WIDTH;
+    header.height = BOARD_HEIGHT;
+    header.num_ships = NUM_SHIPS;
+    header.record_size = RECORD_SIZE;
+    memcpy(header.lengths, fleet, NUM_SHIPS);
+    header.fleets = full;
+    header.records = records.count;
+
+    file = fopen(path, "wb");
+    if (file == NULL
+        || fwrite(&header, sizeof(header), 1, file) != 1
+        || fwrite(records.data, RECORD_SIZE, records.count, file) != (size_t) records.count
+        || fclose(file) != 0) {
+        fprintf(stderr, "cannot write %s\n", path);
+        return 1;
+    }
+    printf("wrote %s: %ld bytes\n", path, (long) (sizeof(header) + records.count * RECORD_SIZE));
+    free(records.data);
+    return 0;
+}
@@ -0,0 +1,162 @@
+/**
+@file       fleets.c
+@authors    Jordan Griffiths (jlg108) & Jonty Trombik (jat157)
+@date       17 October 2026
+
+@brief      Enumeration of every legal ordered fleet (see fleets.h).
+**/
+
+#include <string.h>
+#include "fleets.h"
+
+
+/** Fleet being placed */
+static const uint8_t fleet[NUM_SHIPS] = SHIP_LENGTHS;
+
+
+/** Search state shared by every level of the depth-first search */
+typedef struct search {
+    fleet_visit_t visit;
+    void* context;
+    bool reduce;                        //TRUE to search one first ship placement per flip orbit
+    uint8_t keys[NUM_SHIPS];            //Ship keys of the ships placed so far
+    uint8_t weight;                     //Fleets each fleet found stands for
+} Search;
+
+
+/**
+Key for one ship placement
+@param rot rotation of ship
+@param x column of first cell
+@param y row of first cell
+@return ship key, less than 2^SHIP_KEY_BITS
+*/
+uint8_t ship_key(rotation_t rot, uint8_t x, uint8_t y)
+{
+    return rot * BOARD_WIDTH * BOARD_HEIGHT + x * BOARD_HEIGHT + y;
+}
+
+
+/**
+Key for a whole fleet, packing its ship keys
+@param keys ship key of each ship, in fleet order
+@return fleet key, less than FLEET_KEYS
+*/
+long fleet_key_of(const uint8_t keys[NUM_SHIPS])
+{
+    long key = 0;
+    uint8_t s;
+    for (s = 0; s < NUM_SHIPS; s++) {
+        key |= (long) keys[s] << (SHIP_KEY_BITS * s);
+    }
+    return key;
+}
+
+
+/**
+Image of a ship placement under a flip of the board
+@param key ship key
+@param length length of ship
+@param flip combination of FLIP_X and FLIP_Y
+@return ship key of the flipped placement
+*/
+uint8_t flip_ship_key(uint8_t key, uint8_t length, uint8_t flip)
+{
+    rotation_t rot = key / (BOARD_WIDTH * BOARD_HEIGHT);
+    uint8_t x = key / BOARD_HEIGHT % BOARD_WIDTH;
+    uint8_t y = key % BOARD_HEIGHT;
+
+    //The first cell of a flipped ship is the image of its last cell along the flip
+    if (flip & FLIP_X) {
+        x = BOARD_WIDTH - x - (rot == HORIZ ? length : 1);
+    }
+    if (flip & FLIP_Y) {
+        y = BOARD_HEIGHT - y - (rot == VERT ? length : 1);
+    }
+    return ship_key(rot, x, y);
+}
+
+
+/**
+Place ships from s onwards on every legal position, using the board.c
+rules, and visit each complete fleet
+@param search search state
+@param board board holding the ships placed so far
+@param s index of next ship to place
+@return number of legal fleets found, counting weights
+*/
+static long search_from(Search* search, Board* board, uint8_t s)
+{
+    long found = 0;
+    uint8_t rot, x, y;
+
+    if (s == NUM_SHIPS) {
+        if (search->visit != NULL) {
+            search->visit(search->keys, search->weight, search->context);
+        }
+        return search->weight;
+    }
+
+    for (rot = HORIZ; rot <= VERT; rot++) {
+        for (x = 0; x + (rot == HORIZ ? fleet[s] - 1 : 0) < BOARD_WIDTH; x++) {
+            for (y = 0; y + (rot == VERT ? fleet[s] - 1 : 0) < BOARD_HEIGHT; y++) {
+                Board next = *board;
+                uint8_t key = ship_key(rot, x, y);
+                uint8_t flip, orbit = 1;
+
+                if (s == 0 && search->reduce) {
+                    //Reduced search: only the smallest key of each first ship orbit
+                    bool smallest = TRUE;
+                    for (flip = 1; flip < NUM_FLIPS; flip++) {
+                        uint8_t image = flip_ship_key(key, fleet[s], flip);
+                        uint8_t seen;
+                        smallest &= image >= key;
+                        //Count distinct images, each the first flip to reach it
+                        for (seen = 0; seen < flip && flip_ship_key(key, fleet[s], seen) != image; seen++) {
+                            continue;
+                        }
+                        orbit += seen == flip;
+                    }
+                    if (!smallest) {
+                        continue;
+                    }
+                }
+
+                next.cur_ship_num = s;
+                next.cur_ship.length = fleet[s];
+                next.cur_ship.rot = rot;
+                next.cur_ship.pos = tinygl_point(x, y);
+                update_ship_mask(&next);
+                if (place_ship(&next)) {
+                    search->keys[s] = key;
+                    if (s == 0) {
+                        search->weight = orbit;
+                    }
+                    found += search_from(search, &next, s + 1);
+                }
+            }
+        }
+    }
+    return found;
+}
+
+
+/**
+Find every legal ordered fleet
+@param reduce TRUE to search one first ship placement per flip orbit
+@param visit called for each fleet found (may be NULL)
+@param context passed to visit
+@return number of legal ordered fleets, counting each fleet's weight
+*/
+long fleets_enumerate(bool reduce, fleet_visit_t visit, void* context)
+{
+    Search search;
+    Board board;
+
+    search.visit = visit;
+    search.context = context;
+    search.reduce = reduce;
+    search.weight = 1;
+    board_init(&board);
+    return search_from(&search, &board, 0);
+}
@@ -0,0 +1,82 @@
+/**
+@file       fleets.h
+@authors    Jordan Griffiths (jlg108) & Jonty Trombik (jat157)
+@date       17 October 2026
+
+@brief      Enumeration of every legal ordered fleet, by depth-first
+            search over the board.c placement rules. Optionally only one
+            first ship placement from each orbit under the board's
+            horizontal and vertical flips is searched, which cuts the work
+            about four times; each fleet found then stands for its images
+            under the flips that move the first ship.
+**/
+
+#ifndef FLEETS_H
+#define FLEETS_H
+
+#include "board.h"
+
+
+/** Bits identifying one ship's placement: rotation and first cell */
+#define SHIP_KEY_BITS 7
+#define FLEET_KEYS (1L << (SHIP_KEY_BITS * NUM_SHIPS))
+
+#if 2 * BOARD_WIDTH * BOARD_HEIGHT > (1 << SHIP_KEY_BITS)
+#error "SHIP_KEY_BITS is too small for the board"
+#endif
+
+
+/** Flips of the board: none, horizontal (x mirrored), vertical (y mirrored) and both */
+#define NUM_FLIPS 4
+#define FLIP_X 1
+#define FLIP_Y 2
+
+
+/**
+Called for each fleet found
+@param keys ship key of each ship, in fleet order
+@param weight number of legal fleets the fleet stands for (1 without reduction)
+@param context caller's state
+*/
+typedef void (*fleet_visit_t)(const uint8_t keys[NUM_SHIPS], uint8_t weight, void* context);
+
+
+/**
+Key for one ship placement
+@param rot rotation of ship
+@param x column of first cell
+@param y row of first cell
+@return ship key, less than 2^SHIP_KEY_BITS
+*/
+uint8_t ship_key(rotation_t rot, uint8_t x, uint8_t y);
+
+
+/**
+Key for a whole fleet, packing its ship keys
+@param keys ship key of each ship, in fleet order
+@return fleet key, less than FLEET_KEYS
+*/
+long fleet_key_of(const uint8_t keys[NUM_SHIPS]);
+
+
+/**
+Image of a ship placement under a flip of the board
+@param key ship key
+@param length length of ship
+@param flip combination of FLIP_X and FLIP_Y
+@return ship key of the flipped placement
+*/
+uint8_t flip_ship_key(uint8_t key, uint8_t length, uint8_t flip);
+
+
+/**
+Find every legal ordered fleet
+@param reduce TRUE to search one first ship placement per flip orbit
+@param visit called for each fleet found (may be NULL)
+@param context passed to visit
+@return number of legal ordered fleets, counting each fleet's weight
+*/
+long fleets_enumerate(bool reduce, fleet_visit_t visit, void* context);
+
+
+#endif
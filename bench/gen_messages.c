@@ -0,0 +1,147 @@
+/**
+@file       gen_messages.c
+@authors    Jordan Griffiths (jlg108) & Jonty Trombik (jat157)
+@date       17 October 2026
+
+@brief      Host tool that renders the status messages with font3x5_1,
+            through the UCFK4 font module, and prints them as messages.c
+            in the strip layout described in messages.h. The top level
+            Makefile runs it whenever the font or this file changes.
+
+            Usage: gen_messages > ../messages.c
+**/
+
+#include <stdio.h>
+#include <string.h>
+#include "display.h"
+#include "font.h"
+#include "font3x5_1.h"
+
+
+/** Columns taken by one character of message text, as messages.h */
+#define MESSAGE_CHAR_COLUMNS 4
+
+
+/** Longest message text, in characters */
+#define MAX_CHARS 24
+
+
+/** Bytes in the longest strip: every text column, the repeat and padding */
+#define MAX_STRIP ((MAX_CHARS * MESSAGE_CHAR_COLUMNS + DISPLAY_HEIGHT + 7) / 8 + 1)
+
+
+/** A message to render */
+typedef struct message_text {
+    const char* name;                   //Message is msg_<name>, strips <name>_strips
+    const char* text;                   //Text, with the spaces tinygl padded it with
+} MessageText;
+
+
+/** Status messages, in messages.h order */
+static const MessageText messages[] = {
+    {"ready", "  READY?"},
+    {"win", "  YOU WIN!  "},
+    {"lose", "  YOU LOSE! "},
+    {"play_again", "  PUSH TO PLAY AGAIN!"},
+    {"start", "  PUSH TO START!"},
+    {"hit", " HIT  "},
+    {"miss", " MISS"},
+    {"sunk", " SUNK  "},
+};
+#define NUM_MESSAGES (sizeof(messages) / sizeof(messages[0]))
+
+
+/**
+Read one pixel of a message
+@param text message text
+@param t text column, wrapping after the last
+@param row glyph row
+@return TRUE (1) if the pixel is lit, FALSE (0) otherwise
+*/
+static bool text_pixel(const char* text, uint16_t t, uint8_t row)
+{
+    uint16_t length = strlen(text) * MESSAGE_CHAR_COLUMNS;
+    uint8_t col;
+
+    t %= length;
+    col = t % MESSAGE_CHAR_COLUMNS;
+    return col < font3x5_1.width && font_pixel_get(&font3x5_1, text[t / MESSAGE_CHAR_COLUMNS], col, row);
+}
+
+
+/**
+Print the strips of one message. Strip x holds glyph row x, with text
+column t at bit (length + DISPLAY_HEIGHT - 1 - t), stored least
+significant byte first.
+@param message message to print
+@return bytes per strip
+*/
+static uint8_t print_strips(const MessageText* message)
+{
+    uint16_t length = strlen(message->text) * MESSAGE_CHAR_COLUMNS;
+    uint8_t stride = (length + DISPLAY_HEIGHT + 7) / 8 + 1;
+    const char* start = message->text + strspn(message->text, " ");
+    int trimmed = strlen(start);
+    uint8_t x, i;
+    uint16_t t;
+
+    //The comment shows the text without its padding
+    while (trimmed > 0 && start[trimmed - 1] == ' ') {
+        trimmed--;
+    }
+    printf("\n\n/** \"%.*s\" (%d columns) */\n", trimmed, start, length);
+    printf("static const uint8_t %s_strips[] PROGMEM =\n{\n", message->name);
+    for (x = 0; x < DISPLAY_WIDTH; x++) {
+        uint8_t strip[MAX_STRIP] = {0};
+        for (t = 0; t < length + DISPLAY_HEIGHT; t++) {
+            uint16_t bit = length + DISPLAY_HEIGHT - 1 - t;
+            if (text_pixel(message->text, t, x)) {
+                strip[bit / 8] |= 1 << (bit % 8);
+            }
+        }
+        printf("   ");
+        for (i = 0; i < stride; i++) {
+            printf(" 0x%02x,", strip[i]);
+        }
+        printf("\n");
+    }
+    printf("};\n");
+    return stride;
+}
+
+
+int main(void)
+{
+    uint8_t strides[NUM_MESSAGES];
+    unsigned int m;
+
+    for (m = 0; m < NUM_MESSAGES; m++) {
+        if (strlen(messages[m].text) > MAX_CHARS) {
+            fprintf(stderr, "message %s is longer than %d characters\n", messages[m].name, MAX_CHARS);
+            return 1;
+        }
+    }
+
+    printf("/**\n"
+           "@file       messages.c\n"
+           "@authors    Jordan Griffiths (jlg108) & Jonty Trombik (jat157)\n"
+           "@date       17 October 2026\n"
+           "\n"
+           "@brief      Pre-rendered status messages. Text is rendered from 3x5\n"
+           "            capitals with a blank column between characters, including the\n"
+           "            leading and trailing spaces tinygl used to pad each message.\n"
+           "            Generated by bench/gen_messages.c from font3x5_1; edit the\n"
+           "            messages there.\n"
+           "**/\n"
+           "\n"
+           "#include \"messages.h\"\n");
+    for (m = 0; m < NUM_MESSAGES; m++) {
+        strides[m] = print_strips(&messages[m]);
+    }
+    printf("\n\n/** Messages */\n");
+    for (m = 0; m < NUM_MESSAGES; m++) {
+        printf("const Message msg_%s PROGMEM = {%s_strips, %d, %d};\n", messages[m].name, messages[m].name,
+               (int) strlen(messages[m].text) * MESSAGE_CHAR_COLUMNS, strides[m]);
+    }
+    return 0;
+}
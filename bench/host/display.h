@@ -0,0 +1,17 @@
+/**
+@file       display.h
+@authors    Jordan Griffiths (jlg108) & Jonty Trombik (jat157)
+@date       17 October 2026
+
+@brief      Host stand-in for the UCFK4 display header (dimensions only).
+**/
+
+#ifndef DISPLAY_H
+#define DISPLAY_H
+
+#include "system.h"
+
+#define DISPLAY_WIDTH LEDMAT_COLS_NUM
+#define DISPLAY_HEIGHT LEDMAT_ROWS_NUM
+
+#endif
@@ -0,0 +1,26 @@
+/**
+@file       ir_uart.h
+@authors    Jordan Griffiths (jlg108) & Jonty Trombik (jat157)
+@date       17 October 2026
+
+@brief      Host stand-in for the UCFK4 IR UART driver. The benchmark
+            that includes it supplies the functions, modelling the
+            channel between two boards.
+**/
+
+#ifndef IR_UART_H
+#define IR_UART_H
+
+#include "system.h"
+
+void ir_uart_init(void);
+
+bool ir_uart_read_ready_p(void);
+
+char ir_uart_getc(void);
+
+bool ir_uart_write_ready_p(void);
+
+void ir_uart_putc(char ch);
+
+#endif
@@ -0,0 +1,23 @@
+/**
+@file       system.h
+@authors    Jordan Griffiths (jlg108) & Jonty Trombik (jat157)
+@date       17 October 2026
+
+@brief      Host stand-in for the UCFK4 system header, so game modules
+            can be built into host benchmarks.
+**/
+
+#ifndef SYSTEM_H
+#define SYSTEM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define F_CPU 8000000
+
+#define BIT(X) (1 << (X))
+
+#define LEDMAT_COLS_NUM 5
+#define LEDMAT_ROWS_NUM 7
+
+#endif
@@ -0,0 +1,20 @@
+/**
+@file       timer.h
+@authors    Jordan Griffiths (jlg108) & Jonty Trombik (jat157)
+@date       17 October 2026
+
+@brief      Host stand-in for the UCFK4 timer driver. Only the tick type
+            is needed by the modules built into host benchmarks; the
+            benchmark supplies timer_get if it calls it.
+**/
+
+#ifndef TIMER_H
+#define TIMER_H
+
+#include "system.h"
+
+typedef uint16_t timer_tick_t;
+
+timer_tick_t timer_get(void);
+
+#endif
@@ -0,0 +1,28 @@
+/**
+@file       tinygl.h
+@authors    Jordan Griffiths (jlg108) & Jonty Trombik (jat157)
+@date       17 October 2026
+
+@brief      Host stand-in for the UCFK4 tinygl header (points only).
+**/
+
+#ifndef TINYGL_H
+#define TINYGL_H
+
+#include "system.h"
+#include "display.h"
+
+typedef int8_t tinygl_coord_t;
+
+typedef struct tinygl_point {
+    tinygl_coord_t x;
+    tinygl_coord_t y;
+} tinygl_point_t;
+
+static inline tinygl_point_t tinygl_point(tinygl_coord_t x, tinygl_coord_t y)
+{
+    tinygl_point_t point = {x, y};
+    return point;
+}
+
+#endif
@@ -0,0 +1,178 @@
+/**
+@file       tcache.c
+@authors    Jordan Griffiths (jlg108) & Jonty Trombik (jat157)
+@date       17 October 2026
+
+@brief      Lock-free transposition cache for targeting results (see
+            tcache.h).
+**/
+
+#include <stdlib.h>
+#include "tcache.h"
+
+
+/** Cells on the board */
+#define CELLS (BOARD_WIDTH * BOARD_HEIGHT)
+
+#if 2 * CELLS + NUM_SHIPS > 128
+#error "A target board state must pack into two 64-bit words"
+#endif
+
+
+/** Zobrist numbers for hit cells, blocked cells and afloat ships */
+static uint64_t zobrist_hit[CELLS];
+static uint64_t zobrist_blocked[CELLS];
+static uint64_t zobrist_afloat[NUM_SHIPS];
+
+
+/**
+Set a bit of a two word key
+@param words key words
+@param bit bit to set, 0 to 127
+*/
+static void key_set(uint64_t words[2], uint8_t bit)
+{
+    words[bit / 64] |= (uint64_t) 1 << (bit % 64);
+}
+
+
+/**
+Allocate an empty cache
+@param cache cache to set up
+@param bits log2 of the number of slots
+@return TRUE (1) on success, FALSE (0) if out of memory
+*/
+bool tcache_init(TCache* cache, uint8_t bits)
+{
+    uint64_t state = 0x9e3779b97f4a7c15u;
+    uint8_t i;
+
+    //Fixed xorshift64 sequence, so slots are the same on every run
+    for (i = 0; i < CELLS + CELLS + NUM_SHIPS; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        if (i < CELLS) {
+            zobrist_hit[i] = state;
+        } else if (i < 2 * CELLS) {
+            zobrist_blocked[i - CELLS] = state;
+        } else {
+            zobrist_afloat[i - 2 * CELLS] = state;
+        }
+    }
+
+    cache->entries = calloc((size_t) 1 << bits, sizeof(TCacheEntry));
+    cache->mask = ((uint64_t) 1 << bits) - 1;
+    cache->lookups = 0;
+    cache->hits = 0;
+    cache->stores = 0;
+    return cache->entries != NULL;
+}
+
+
+/**
+Free a cache's slots
+@param cache cache to free
+*/
+void tcache_free(TCache* cache)
+{
+    free(cache->entries);
+    cache->entries = NULL;
+}
+
+
+/**
+Build the key of a target board state
+@param target targeting state
+@param key key to fill
+*/
+void tcache_key(Targeter* target, TCacheKey* key)
+{
+    uint8_t x, y, s;
+
+    key->hash = 0;
+    key->words[0] = 0;
+    key->words[1] = 0;
+    for (x = 0; x < BOARD_WIDTH; x++) {
+        board_col_t hits = target->hits[x];
+        board_col_t blocked = target->blocked[x];
+        while (hits | blocked) {
+            board_col_t col = hits | blocked;
+            uint8_t cell;
+            y = __builtin_ctzll(col);
+            cell = x * BOARD_HEIGHT + y;
+            if (hits & COL_BIT(y)) {
+                key->hash ^= zobrist_hit[cell];
+                key_set(key->words, cell);
+            }
+            if (blocked & COL_BIT(y)) {
+                key->hash ^= zobrist_blocked[cell];
+                key_set(key->words, CELLS + cell);
+            }
+            hits &= ~COL_BIT(y);
+            blocked &= ~COL_BIT(y);
+        }
+    }
+    for (s = 0; s < NUM_SHIPS; s++) {
+        if (target->afloat & BIT(s)) {
+            key->hash ^= zobrist_afloat[s];
+            key_set(key->words, 2 * CELLS + s);
+        }
+    }
+}
+
+
+/**
+Look up a state (safe from any thread)
+@param cache cache to search
+@param key key of state
+@param value set to the cached result on a hit
+@return TRUE (1) on a hit, FALSE (0) otherwise
+*/
+bool tcache_probe(TCache* cache, TCacheKey* key, TCacheValue* value)
+{
+    TCacheEntry* entry = &cache->entries[key->hash & cache->mask];
+    uint64_t data = __atomic_load_n(&entry->value, __ATOMIC_RELAXED);
+    uint64_t check0 = __atomic_load_n(&entry->check[0], __ATOMIC_RELAXED);
+    uint64_t check1 = __atomic_load_n(&entry->check[1], __ATOMIC_RELAXED);
+
+    //Empty slots hold zero data, which no stored value has
+    if (data == 0 || (check0 ^ data) != key->words[0] || (check1 ^ data) != key->words[1]) {
+        return FALSE;
+    }
+    value->best = tinygl_point(data & 0xff, data >> 8 & 0xff);
+    value->score = data >> 16 & 0xffff;
+    return TRUE;
+}
+
+
+/**
+Store the result for a state, replacing the slot's entry (safe from any thread)
+@param cache cache to update
+@param key key of state
+@param value result to store
+*/
+void tcache_store(TCache* cache, TCacheKey* key, TCacheValue* value)
+{
+    TCacheEntry* entry = &cache->entries[key->hash & cache->mask];
+    uint64_t data = (uint64_t) 1 << 63 | (uint64_t) value->score << 16
+        | (uint64_t) (uint8_t) value->best.y << 8 | (uint8_t) value->best.x;
+
+    __atomic_store_n(&entry->check[0], key->words[0] ^ data, __ATOMIC_RELAXED);
+    __atomic_store_n(&entry->check[1], key->words[1] ^ data, __ATOMIC_RELAXED);
+    __atomic_store_n(&entry->value, data, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&cache->stores, 1, __ATOMIC_RELAXED);
+}
+
+
+/**
+Add a thread's probe counts to the cache's counters (safe from any thread)
+@param cache cache to update
+@param lookups probes made
+@param hits probes that hit
+*/
+void tcache_count(TCache* cache, uint64_t lookups, uint64_t hits)
+{
+    __atomic_fetch_add(&cache->lookups, lookups, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&cache->hits, hits, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,109 @@
+/**
+@file       tcache.h
+@authors    Jordan Griffiths (jlg108) & Jonty Trombik (jat157)
+@date       17 October 2026
+
+@brief      Transposition cache for targeting results, shared by every
+            thread of a host run. Entries are keyed on the target board
+            state a Targeter's counts depend on: its hit and blocked
+            bitmaps and its afloat ships. Keys are Zobrist hashed to pick
+            a slot, and the full key is kept to confirm a match.
+
+            The cache takes no locks. Each slot is three words written
+            and read with relaxed atomics. The value word is stored XORed
+            into both key words, so a slot torn by two threads writing
+            at once fails the match rather than returning a wrong value
+            (after Hyatt's lockless hashing). A new entry always replaces
+            the slot's old one.
+**/
+
+#ifndef TCACHE_H
+#define TCACHE_H
+
+#include "target.h"
+
+
+/** Cached targeting result */
+typedef struct tcache_value {
+    tinygl_point_t best;                //Best cell, as target_best
+    uint16_t score;                     //Its target_score
+} TCacheValue;
+
+
+/** One slot: key words XORed with the value word */
+typedef struct tcache_entry {
+    uint64_t check[2];
+    uint64_t value;
+} TCacheEntry;
+
+
+/** Cache state and hit-rate counters */
+typedef struct tcache {
+    TCacheEntry* entries;
+    uint64_t mask;                      //Slots - 1
+    uint64_t lookups;                   //Probes made, added with tcache_count
+    uint64_t hits;                      //Probes that found their key
+    uint64_t stores;                    //Entries written
+} TCache;
+
+
+/** Key of a target board state, before hashing */
+typedef struct tcache_key {
+    uint64_t hash;                      //Zobrist hash, picks the slot
+    uint64_t words[2];                  //Packed hits, and blocked cells with afloat ships
+} TCacheKey;
+
+
+/**
+Allocate an empty cache
+@param cache cache to set up
+@param bits log2 of the number of slots
+@return TRUE (1) on success, FALSE (0) if out of memory
+*/
+bool tcache_init(TCache* cache, uint8_t bits);
+
+
+/**
+Free a cache's slots
+@param cache cache to free
+*/
+void tcache_free(TCache* cache);
+
+
+/**
+Build the key of a target board state
+@param target targeting state
+@param key key to fill
+*/
+void tcache_key(Targeter* target, TCacheKey* key);
+
+
+/**
+Look up a state (safe from any thread)
+@param cache cache to search
+@param key key of state
+@param value set to the cached result on a hit
+@return TRUE (1) on a hit, FALSE (0) otherwise
+*/
+bool tcache_probe(TCache* cache, TCacheKey* key, TCacheValue* value);
+
+
+/**
+Store the result for a state, replacing the slot's entry (safe from any thread)
+@param cache cache to update
+@param key key of state
+@param value result to store
+*/
+void tcache_store(TCache* cache, TCacheKey* key, TCacheValue* value);
+
+
+/**
+Add a thread's probe counts to the cache's counters (safe from any thread)
+@param cache cache to update
+@param lookups probes made
+@param hits probes that hit
+*/
+void tcache_count(TCache* cache, uint64_t lookups, uint64_t hits);
+
+
+#endif
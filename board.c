@@ -10,59 +10,76 @@
 #include "board.h"
 
 
-/** Board state variable */
-static Ship cur_ship;
-static uint8_t cur_ship_num;
-static tinygl_point_t cursor;
-static tinygl_point_t strike_position;
-static uint8_t game_score;
+/** Define ship lengths array at runtime */
+static uint8_t ship_lengths[NUM_SHIPS] = SHIP_LENGTHS;
 
 
 /**
-Game boards (this and target) stored as bitmaps
-Each 8-bit integer represents a column, with each bit representing a row
+Remove every placed ship from this board
+@param board board state to operate on.
 */
-static uint8_t boards[2][DISPLAY_WIDTH];
-
-
-/** Define ship lengths array at runtime */
-static uint8_t ship_lengths[NUM_SHIPS] = SHIP_LENGTHS;
+static void clear_fleet(Board* board)
+{
+    uint8_t x, y;
+    for (x = 0; x < BOARD_WIDTH; x++) {
+        board->boards[THIS_BOARD][x] = 0;
+        for (y = 0; y < BOARD_HEIGHT; y++) {
+            board->ship_at[x][y] = NO_SHIP;
+        }
+    }
+    board->ships_afloat = 0;
+}
 
 
 /**
 Initialise logic, gameboard and cursor positions
+@param board board state to operate on.
 */
-void board_init(void)
+void board_init(Board* board)
 {
     int i;
-    for (i = 0; i < DISPLAY_WIDTH; i++) {
-        boards[THIS_BOARD][i] = 0;
-        boards[TARGET_BOARD][i] = 0;
+    clear_fleet(board);
+    for (i = 0; i < BOARD_WIDTH; i++) {
+        board->boards[TARGET_BOARD][i] = 0;
+        board->target_low[i] = 0;
+        board->damage[i] = 0;
     }
-    cur_ship_num = 0;
-    game_score = 0;
-    reset_cur_ship(ship_lengths[cur_ship_num]);
-    cursor = tinygl_point(CENTRE_X, CENTRE_Y);
-    strike_position = tinygl_point(0, 0);
+    board->cur_ship_num = 0;
+    board->ships_sunk = 0;
+    reset_cur_ship(board, ship_lengths[board->cur_ship_num]);
+    board->cursor = tinygl_point(CENTRE_X, CENTRE_Y);
+    board->strike_position = tinygl_point(0, 0);
 }
 
 
 /**
 load current ship into game board, if position is valid.
+@param board board state to operate on.
 @return TRUE (1) if ship placement was successful, FALSE (0) otherwise.
 */
-bool place_ship(void)
+bool place_ship(Board* board)
 {
-    if (is_valid_position()) {
+    if (is_valid_position(board)) {
         //Update board bitmap to include new ship points
+        Ship* ship = &board->cur_ship;
+        board_col_t* col = &board->boards[THIS_BOARD][ship->pos.x];
         uint8_t i;
-        for (i = 0; i < cur_ship.length; i++) {
-            if (cur_ship.rot == HORIZ) {
-                boards[THIS_BOARD][cur_ship.pos.x + i] |= BIT(cur_ship.pos.y);
-            } else if (cur_ship.rot == VERT) {
-                boards[THIS_BOARD][cur_ship.pos.x] |= BIT(cur_ship.pos.y + i);
+        for (i = 0; i < ship->span; i++) {
+            col[i] |= ship->run;
+        }
+
+        //Index ship cells for constant time hit and sunk detection
+        if (ship->rot == HORIZ) {
+            for (i = 0; i < ship->length; i++) {
+                board->ship_at[ship->pos.x + i][ship->pos.y] = board->cur_ship_num;
+            }
+        } else {
+            for (i = 0; i < ship->length; i++) {
+                board->ship_at[ship->pos.x][ship->pos.y + i] = board->cur_ship_num;
             }
         }
+        board->ship_health[board->cur_ship_num] = ship->length;
+        board->ships_afloat++;
         return TRUE;
     } else {
         return FALSE;
@@ -72,170 +89,363 @@ bool place_ship(void)
 
 /**
 Verify that current ship position is non-overlapping with other placed ships
+@param board board state to operate on.
 @return TRUE (1) if position is valid, FALSE (0) otherwise.
 */
-bool is_valid_position(void)
+bool is_valid_position(Board* board)
 {
+    const board_col_t* col = &board->boards[THIS_BOARD][board->cur_ship.pos.x];
+    board_col_t overlap = 0;
     uint8_t i;
-    for (i = 0; i < cur_ship.length; i++) {
-        uint8_t x_offset = cur_ship.rot == HORIZ? i : 0;
-        uint8_t y_offset = cur_ship.rot == VERT? i : 0;
-        if (boards[THIS_BOARD][cur_ship.pos.x + x_offset] & BIT(cur_ship.pos.y + y_offset)) {
-            //Intersection with existing ship found
-            return FALSE;
-        }
+    for (i = 0; i < board->cur_ship.span; i++) {
+        overlap |= col[i] & board->cur_ship.run;
     }
-    return TRUE;
+    //Any common bit is an intersection with an existing ship
+    return !overlap;
 }
 
 
 /**
-Verify that strike location was not a previous successful hit.
+Verify that strike location has not been struck before (hit or miss).
+@param board board state to operate on.
 @return TRUE (1) if position is valid, FALSE (0) otherwise.
 */
-bool is_valid_strike(void)
+bool is_valid_strike(Board* board)
 {
-    strike_position = tinygl_point(cursor.x, cursor.y);
-    return !(boards[TARGET_BOARD][cursor.x] >> cursor.y & 1);
+    board->strike_position = tinygl_point(board->cursor.x, board->cursor.y);
+    uint8_t x = board->cursor.x;
+    return !((board->boards[TARGET_BOARD][x] | board->target_low[x]) & COL_BIT(board->cursor.y));
 }
 
 
 /**
-Add successful strike location to target board and increment score
+Add successful strike location to target board, counting any ship sunk
+@param board board state to operate on.
+@param result outcome of strike (hit, sunk or fleet sunk)
 */
-void add_hit(void)
+void add_hit(Board* board, strike_result_t result)
 {
-    boards[TARGET_BOARD][strike_position.x] |= BIT(strike_position.y);
-    game_score += 1;
+    board->boards[TARGET_BOARD][board->strike_position.x] |= COL_BIT(board->strike_position.y);
+    if (result == SUNK || result == FLEET_SUNK) {
+        board->target_low[board->strike_position.x] |= COL_BIT(board->strike_position.y);
+        board->ships_sunk += 1;
+    }
 }
 
 
 /**
-Check whether enemy strike hits a ship.
-@return TRUE (1) for hit, FALSE (0) for miss.
+Record a missed strike location on the target board
+@param board board state to operate on.
 */
-bool is_hit(tinygl_point_t pos)
+void add_miss(Board* board)
 {
-    return (boards[THIS_BOARD][pos.x] >> pos.y) & 1;
+    board->target_low[board->strike_position.x] |= COL_BIT(board->strike_position.y);
 }
 
 
 /**
-Check whether current game score is such that all ships have been sunk.
+Read the state of a target board cell. The state is packed across two
+bit-planes: the target board bitmap (set for hits and sinks) and
+target_low (set for misses and sinks).
+@param board board state to operate on.
+@param x column of cell
+@param y row of cell
+@return unknown, miss, hit or sunk
+*/
+cell_state_t get_cell_state(Board* board, uint8_t x, uint8_t y)
+{
+    uint8_t high = (board->boards[TARGET_BOARD][x] >> y) & 1;
+    uint8_t low = (board->target_low[x] >> y) & 1;
+    return high << 1 | low;
+}
+
+
+/**
+Apply an enemy strike to this board's fleet. Each call costs the same,
+using the cell-to-ship index and per-ship remaining cell counts.
+@param board board state to operate on.
+@param pos position of strike
+@return MISS, HIT, SUNK if the strike sank a ship, or FLEET_SUNK if it sank the last one.
+*/
+strike_result_t is_hit(Board* board, tinygl_point_t pos)
+{
+    board_col_t bit = COL_BIT(pos.y);
+    uint8_t ship;
+
+    if (!(board->boards[THIS_BOARD][pos.x] & bit)) {
+        return MISS;
+    } else if (board->damage[pos.x] & bit) {
+        //Repeat strike on a damaged cell changes nothing
+        return HIT;
+    }
+
+    board->damage[pos.x] |= bit;
+    ship = board->ship_at[pos.x][pos.y];
+    if (--board->ship_health[ship] > 0) {
+        return HIT;
+    }
+    return --board->ships_afloat > 0 ? SUNK : FLEET_SUNK;
+}
+
+
+/**
+Check whether all enemy ships have been sunk.
+@param board board state to operate on.
 @return TRUE (1) if all enemy ships sunk, FALSE (0) otherwise.
 */
-bool is_winner(void)
+bool is_winner(Board* board)
 {
-    return game_score == WINNING_SCORE;
+    return board->ships_sunk == NUM_SHIPS;
 }
 
 
 /**
 Move the ship currently being placed. Updates position in ship struct.
+@param board board state to operate on.
 @param dir direction to move ship.
 */
-void move_ship(dir_t dir)
+void move_ship(Board* board, dir_t dir)
 {
-    uint8_t x_offset = cur_ship.rot == HORIZ? cur_ship.length - 1 : 0;
-    uint8_t y_offset = cur_ship.rot == VERT? cur_ship.length - 1 : 0;
+    uint8_t x_offset = board->cur_ship.rot == HORIZ? board->cur_ship.length - 1 : 0;
+    uint8_t y_offset = board->cur_ship.rot == VERT? board->cur_ship.length - 1 : 0;
 
     if (dir == DIR_W) {
-        cur_ship.pos.x -= cur_ship.pos.x  == 0? 0 : 1;
+        board->cur_ship.pos.x -= board->cur_ship.pos.x  == 0? 0 : 1;
     } else if (dir == DIR_E) {
-        cur_ship.pos.x += cur_ship.pos.x + x_offset == DISPLAY_WIDTH - 1? 0 : 1;
+        board->cur_ship.pos.x += board->cur_ship.pos.x + x_offset == BOARD_WIDTH - 1? 0 : 1;
     } else if (dir == DIR_N) {
-        cur_ship.pos.y -= cur_ship.pos.y == 0? 0 : 1;
+        board->cur_ship.pos.y -= board->cur_ship.pos.y == 0? 0 : 1;
     } else if (dir == DIR_S) {
-        cur_ship.pos.y += cur_ship.pos.y + y_offset == DISPLAY_HEIGHT - 1? 0 : 1;
+        board->cur_ship.pos.y += board->cur_ship.pos.y + y_offset == BOARD_HEIGHT - 1? 0 : 1;
     }
+    update_ship_mask(board);
 }
 
 
 /**
 Move the strike cursor.
+@param board board state to operate on.
 @param dir direction to move cursor.
 */
-void move_cursor(dir_t dir)
+void move_cursor(Board* board, dir_t dir)
 {
     if (dir == DIR_W) {
-        cursor.x -= cursor.x  == 0? 0 : 1;
+        board->cursor.x -= board->cursor.x  == 0? 0 : 1;
     } else if (dir == DIR_E) {
-        cursor.x += cursor.x == DISPLAY_WIDTH - 1? 0 : 1;
+        board->cursor.x += board->cursor.x == BOARD_WIDTH - 1? 0 : 1;
     } else if (dir == DIR_N) {
-        cursor.y -= cursor.y == 0? 0 : 1;
+        board->cursor.y -= board->cursor.y == 0? 0 : 1;
     } else if (dir == DIR_S) {
-        cursor.y += cursor.y == DISPLAY_HEIGHT - 1? 0 : 1;
+        board->cursor.y += board->cursor.y == BOARD_HEIGHT - 1? 0 : 1;
     }
 }
 
 
 /**
 Accessor method for external modules to access ship being placed
+@param board board state to operate on.
 @return pointer to current ship structure
 */
-Ship* get_ship(void)
+Ship* get_ship(Board* board)
 {
-    return &cur_ship;
+    return &board->cur_ship;
 }
 
 
 /**
 Accessor method for external modules to access cursor position
+@param board board state to operate on.
 @return cursor location
 */
-tinygl_point_t get_cursor(void)
+tinygl_point_t get_cursor(Board* board)
 {
-    return cursor;
+    return board->cursor;
 }
 
 
 /**
 Accessor method for external modules to access gameboard
+@param board board state to operate on.
 @param board_type specifies which game board (this or target)
 @return pointer to board bitmap
 */
-uint8_t* get_board(board_type_t board_type)
+board_col_t* get_board(Board* board, board_type_t board_type)
 {
-    return boards[board_type];
+    return board->boards[board_type];
+}
+
+
+/**
+Accessor method for external modules to access the low bit-plane of the
+target board (see get_cell_state)
+@param board board state to operate on.
+@return pointer to target board low bit-plane
+*/
+board_col_t* get_target_low(Board* board)
+{
+    return board->target_low;
 }
 
 
 /**
 Rotate current ship by 90 degrees
+@param board board state to operate on.
 */
-void rotate_ship(void)
+void rotate_ship(Board* board)
 {
-    cur_ship.pos = tinygl_point(0,0);
-    cur_ship.rot = (cur_ship.rot + 1) % 2;
+    board->cur_ship.pos = tinygl_point(0,0);
+    board->cur_ship.rot = (board->cur_ship.rot + 1) % 2;
+    update_ship_mask(board);
 }
 
 
 /**
 Reset current ship to be placed with a new length
 (used after previous ship has been placed).
+@param board board state to operate on.
 @param newlen length of next ship to be placed.
 */
-void reset_cur_ship(uint8_t newlen)
+void reset_cur_ship(Board* board, uint8_t newlen)
 {
-    cur_ship.length = newlen;
-    cur_ship.pos = tinygl_point(2,3);
-    cur_ship.rot = VERT;
+    board->cur_ship.length = newlen;
+    board->cur_ship.pos = tinygl_point(CENTRE_X, CENTRE_Y);
+    board->cur_ship.rot = VERT;
+    update_ship_mask(board);
+}
+
+
+/**
+Recompute the column mask and span of the current ship from its position,
+rotation and length. A horizontal ship has one bit in each of length
+columns, a vertical one a run of length bits in one column, so checking or
+placing it touches only the columns it spans. Must be called whenever any
+of these change.
+@param board board state to operate on.
+*/
+void update_ship_mask(Board* board)
+{
+    Ship* ship = &board->cur_ship;
+    if (ship->rot == HORIZ) {
+        ship->run = COL_BIT(ship->pos.y);
+        ship->span = ship->length;
+    } else {
+        ship->run = RUN_MASK(ship->length) << ship->pos.y;
+        ship->span = 1;
+    }
+}
+
+
+/**
+Advance a xorshift pseudo-random state.
+@param state random state to advance (must be non-zero)
+@return next pseudo-random number
+*/
+uint32_t random_next(uint32_t* state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+
+/**
+Mix an entropy sample (e.g. the timing of an input event) into a
+xorshift state. Apart from the one sample that would zero the state,
+distinct samples leave distinct states, so every bit of the sample
+reaches the generator.
+@param state random state to update
+@param sample entropy sample
+*/
+void random_stir(uint32_t* state, uint32_t sample)
+{
+    *state ^= sample;
+    if (*state == 0) {
+        //Zero is the one state xorshift cannot leave
+        *state = 1;
+    }
+    random_next(state);
+}
+
+
+/**
+Move the current ship to a position and rotation drawn uniformly from all
+of its on-board placements.
+@param board board state to operate on.
+@param rng random state to draw from.
+*/
+void random_ship_position(Board* board, uint32_t* rng)
+{
+    uint8_t len = board->cur_ship.length;
+    uint8_t horiz_cols = BOARD_WIDTH - len + 1;
+    uint8_t vert_rows = BOARD_HEIGHT - len + 1;
+    uint16_t horiz_count = horiz_cols * BOARD_HEIGHT;
+    uint16_t pick = random_next(rng) % (horiz_count + BOARD_WIDTH * vert_rows);
+
+    if (pick < horiz_count) {
+        board->cur_ship.rot = HORIZ;
+        board->cur_ship.pos = tinygl_point(pick % horiz_cols, pick / horiz_cols);
+    } else {
+        pick -= horiz_count;
+        board->cur_ship.rot = VERT;
+        board->cur_ship.pos = tinygl_point(pick % BOARD_WIDTH, pick / BOARD_WIDTH);
+    }
+    update_ship_mask(board);
+}
+
+
+/**
+Make one attempt at placing the whole fleet at random. Any ships already
+placed are cleared. An attempt fails if two ships overlap, and repeating
+attempts until one succeeds draws uniformly from all legal fleets.
+@param board board state to operate on.
+@param rng random state to draw from.
+@return TRUE (1) if the fleet was placed, FALSE (0) otherwise.
+*/
+bool random_fleet_attempt(Board* board, uint32_t* rng)
+{
+    clear_fleet(board);
+    board->cur_ship_num = 0;
+    reset_cur_ship(board, ship_lengths[board->cur_ship_num]);
+
+    do {
+        random_ship_position(board, rng);
+        if (!place_ship(board)) {
+            return FALSE;
+        }
+    } while (next_ship(board));
+
+    return TRUE;
+}
+
+
+/**
+Place the whole fleet at a uniformly random legal configuration.
+@param board board state to operate on.
+@param rng random state to draw from.
+*/
+void auto_place(Board* board, uint32_t* rng)
+{
+    while (!random_fleet_attempt(board, rng)) {
+        continue;
+    }
 }
 
 
 /**
 Attempts to generate next ship to be placed.
+@param board board state to operate on.
 @returns FALSE (0) if no more ships, TRUE (1) otherwise
 */
-bool next_ship(void)
+bool next_ship(Board* board)
 {
-    cur_ship_num++;
-    if (cur_ship_num == NUM_SHIPS) {
+    board->cur_ship_num++;
+    if (board->cur_ship_num == NUM_SHIPS) {
         //No ships remaining
         return FALSE;
     } else {
         //Go to next ship
-        reset_cur_ship(ship_lengths[cur_ship_num]);
+        reset_cur_ship(board, ship_lengths[board->cur_ship_num]);
         return TRUE;
     }
 }
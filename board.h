@@ -20,19 +20,62 @@
 
 /** Game customisation parameters */
 #define NUM_SHIPS 3
-#define WINNING_SCORE 9
 #define SHIP_LENGTHS {2,3,4}
 
 
-/** Board dimension macros */
-#define CENTRE_X 2
-#define CENTRE_Y 3
+/** Ship index for cells not covered by any ship */
+#define NO_SHIP 0xff
+
+
+/** Board dimension macros (default to the LED matrix, override for larger boards) */
+#ifndef BOARD_WIDTH
+#define BOARD_WIDTH DISPLAY_WIDTH
+#endif
+#ifndef BOARD_HEIGHT
+#define BOARD_HEIGHT DISPLAY_HEIGHT
+#endif
+#define CENTRE_X (BOARD_WIDTH / 2)
+#define CENTRE_Y (BOARD_HEIGHT / 2)
+
+
+/**
+Board column type, holding one bit per row. The narrowest type that fits
+BOARD_HEIGHT is used, so the 5x7 device board keeps byte columns.
+*/
+#if BOARD_HEIGHT <= 8
+typedef uint8_t board_col_t;
+#elif BOARD_HEIGHT <= 16
+typedef uint16_t board_col_t;
+#elif BOARD_HEIGHT <= 32
+typedef uint32_t board_col_t;
+#elif BOARD_HEIGHT <= 64
+typedef uint64_t board_col_t;
+#else
+#error "BOARD_HEIGHT must be at most 64"
+#endif
+
+#if BOARD_WIDTH > 127
+#error "BOARD_WIDTH must fit in a tinygl coordinate"
+#endif
+
+
+/** Column mask for row y */
+#define COL_BIT(y) ((board_col_t) 1 << (y))
+
+
+/** Column mask for a vertical run of n (> 0) cells starting at row 0 */
+#define RUN_MASK(n) ((board_col_t) (((board_col_t) 2 << ((n) - 1)) - 1))
+
+
+/** TRUE for any strike result that hit a ship */
+#define IS_HIT_RESULT(result) ((result) != MISS)
 
 
 /** Board specific enumeration definitions */
 typedef enum rotation {HORIZ, VERT} rotation_t;
 typedef enum board_type {THIS_BOARD, TARGET_BOARD} board_type_t;
-typedef enum strike_result {HIT, MISS} strike_result_t;
+typedef enum strike_result {HIT, MISS, SUNK, FLEET_SUNK} strike_result_t;
+typedef enum cell_state {CELL_UNKNOWN, CELL_MISS, CELL_HIT, CELL_SUNK} cell_state_t;
 typedef enum dir {
     DIR_N, DIR_E, DIR_S,
     DIR_W, DIR_DOWN, DIR_NONE
@@ -44,111 +87,236 @@ typedef struct ship {
     tinygl_point_t pos;
     rotation_t rot;
     int length;
+    board_col_t run;                    //Column mask of the ship's cells, the same in every column it spans
+    uint8_t span;                       //Columns spanned, from pos.x
 } Ship;
 
 
+/**
+Structure definition for one player's board state. Every board routine
+operates on an explicit instance, so any number of games can coexist.
+*/
+typedef struct board {
+    Ship cur_ship;                      //Ship currently being placed
+    uint8_t cur_ship_num;               //Index of ship being placed
+    tinygl_point_t cursor;              //Strike cursor position
+    tinygl_point_t strike_position;     //Location of the last strike fired
+    uint8_t ships_sunk;                 //Number of enemy ships sunk
+    board_col_t boards[2][BOARD_WIDTH]; //This and target boards, one bit per cell
+    board_col_t target_low[BOARD_WIDTH]; //Target board cell state low bit (target board holds the high bit)
+    board_col_t damage[BOARD_WIDTH];    //Cells of this board struck by the enemy
+    uint8_t ship_at[BOARD_WIDTH][BOARD_HEIGHT]; //Index of ship on each cell, NO_SHIP where there is none
+    uint8_t ship_health[NUM_SHIPS];     //Unstruck cells remaining on each placed ship
+    uint8_t ships_afloat;               //Placed ships with unstruck cells remaining
+} Board;
+
+
 /**
 Initialise logic, gameboard and cursor positions
+@param board board state to operate on.
 */
-void board_init(void);
+void board_init(Board* board);
 
 
 /**
 load current ship into game board, if position is valid.
+@param board board state to operate on.
 @return TRUE (1) if ship placement was successful, FALSE (0) otherwise.
 */
-bool place_ship(void);
+bool place_ship(Board* board);
 
 
 /**
 Verify that current ship position is non-overlapping with other placed ships
+@param board board state to operate on.
 @return TRUE (1) if position is valid, FALSE (0) otherwise.
 */
-bool is_valid_position(void);
+bool is_valid_position(Board* board);
 
 
 /**
-Verify that strike location was not a previous successful hit.
+Verify that strike location has not been struck before (hit or miss).
+@param board board state to operate on.
 @return TRUE (1) if position is valid, FALSE (0) otherwise.
 */
-bool is_valid_strike(void);
+bool is_valid_strike(Board* board);
+
+
+/**
+Add successful strike location to target board, counting any ship sunk
+@param board board state to operate on.
+@param result outcome of strike (hit, sunk or fleet sunk)
+*/
+void add_hit(Board* board, strike_result_t result);
+
+
+/**
+Record a missed strike location on the target board
+@param board board state to operate on.
+*/
+void add_miss(Board* board);
 
 
 /**
-Add successful strike location to target board and increment score
+Read the state of a target board cell. The state is packed across two
+bit-planes: the target board bitmap (set for hits and sinks) and
+target_low (set for misses and sinks).
+@param board board state to operate on.
+@param x column of cell
+@param y row of cell
+@return unknown, miss, hit or sunk
 */
-void add_hit(void);
+cell_state_t get_cell_state(Board* board, uint8_t x, uint8_t y);
 
 
 /**
-Check whether enemy strike hits a ship.
-@return TRUE (1) for hit, FALSE (0) for miss.
+Apply an enemy strike to this board's fleet. Each call costs the same,
+using the cell-to-ship index and per-ship remaining cell counts.
+@param board board state to operate on.
+@param pos position of strike
+@return MISS, HIT, SUNK if the strike sank a ship, or FLEET_SUNK if it sank the last one.
 */
-bool is_hit(tinygl_point_t pos);
+strike_result_t is_hit(Board* board, tinygl_point_t pos);
 
 
 /**
-Check whether current game score is such that all ships have been sunk.
+Check whether all enemy ships have been sunk.
+@param board board state to operate on.
 @return TRUE (1) if all enemy ships sunk, FALSE (0) otherwise.
 */
-bool is_winner(void);
+bool is_winner(Board* board);
 
 
 /**
 Move the ship currently being placed. Updates position in ship struct.
+@param board board state to operate on.
 @param dir direction to move ship.
 */
-void move_ship(dir_t dir);
+void move_ship(Board* board, dir_t dir);
 
 
 /**
 Move the strike cursor.
+@param board board state to operate on.
 @param dir direction to move cursor.
 */
-void move_cursor(dir_t dir);
+void move_cursor(Board* board, dir_t dir);
 
 
 /**
 Accessor method for external modules to access ship being placed
+@param board board state to operate on.
 @return pointer to current ship structure
 */
-Ship* get_ship(void);
+Ship* get_ship(Board* board);
 
 
 /**
 Accessor method for external modules to access cursor position
+@param board board state to operate on.
 @return cursor location
 */
-tinygl_point_t get_cursor(void);
+tinygl_point_t get_cursor(Board* board);
 
 
 /**
 Accessor method for external modules to access gameboard
+@param board board state to operate on.
 @param board_type specifies which game board (this or target)
 @return pointer to board bitmap
 */
-uint8_t* get_board(board_type_t board_type);
+board_col_t* get_board(Board* board, board_type_t board_type);
+
+
+/**
+Accessor method for external modules to access the low bit-plane of the
+target board (see get_cell_state)
+@param board board state to operate on.
+@return pointer to target board low bit-plane
+*/
+board_col_t* get_target_low(Board* board);
 
 
 /**
 Rotate current ship by 90 degrees
+@param board board state to operate on.
 */
-void rotate_ship(void);
+void rotate_ship(Board* board);
 
 
 /**
 Reset current ship to be placed with a new length
 (used after previous ship has been placed).
+@param board board state to operate on.
 @param newlen length of next ship to be placed.
 */
-void reset_cur_ship(uint8_t newlen);
+void reset_cur_ship(Board* board, uint8_t newlen);
+
+
+/**
+Recompute the column mask and span of the current ship from its position,
+rotation and length. A horizontal ship has one bit in each of length
+columns, a vertical one a run of length bits in one column, so checking or
+placing it touches only the columns it spans. Must be called whenever any
+of these change.
+@param board board state to operate on.
+*/
+void update_ship_mask(Board* board);
+
+
+/**
+Advance a xorshift pseudo-random state.
+@param state random state to advance (must be non-zero)
+@return next pseudo-random number
+*/
+uint32_t random_next(uint32_t* state);
+
+
+/**
+Mix an entropy sample (e.g. the timing of an input event) into a
+xorshift state. Apart from the one sample that would zero the state,
+distinct samples leave distinct states, so every bit of the sample
+reaches the generator.
+@param state random state to update
+@param sample entropy sample
+*/
+void random_stir(uint32_t* state, uint32_t sample);
+
+
+/**
+Move the current ship to a position and rotation drawn uniformly from all
+of its on-board placements.
+@param board board state to operate on.
+@param rng random state to draw from.
+*/
+void random_ship_position(Board* board, uint32_t* rng);
+
+
+/**
+Make one attempt at placing the whole fleet at random. Any ships already
+placed are cleared. An attempt fails if two ships overlap, and repeating
+attempts until one succeeds draws uniformly from all legal fleets.
+@param board board state to operate on.
+@param rng random state to draw from.
+@return TRUE (1) if the fleet was placed, FALSE (0) otherwise.
+*/
+bool random_fleet_attempt(Board* board, uint32_t* rng);
+
+
+/**
+Place the whole fleet at a uniformly random legal configuration.
+@param board board state to operate on.
+@param rng random state to draw from.
+*/
+void auto_place(Board* board, uint32_t* rng);
 
 
 /**
 Attempts to generate next ship to be placed.
+@param board board state to operate on.
 @returns FALSE (0) if no more ships, TRUE (1) otherwise
 */
-bool next_ship(void);
+bool next_ship(Board* board);
 
 
 #endif
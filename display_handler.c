@@ -7,214 +7,297 @@
 **/
 
 
+#include <avr/io.h>
+#include <avr/interrupt.h>
 #include "display_handler.h"
 
 
 
-/** Array defining points for tick animation (in order) */
-static tinygl_point_t tick_points[NUM_TICK_POINTS] =
+/**
+Frame buffer for graphics and text, one bit-plane per brightness bit, each
+one byte per column with one bit per row. Scanned straight to the LED
+matrix, one column per tick. Each column shows plane 0 until a timer1
+compare B match partway through its slot switches it to plane 1.
+*/
+static uint8_t frame[DISPLAY_PLANES][DISPLAY_WIDTH];
+static uint8_t scan_col;                //Next frame column to light
+static volatile uint8_t lit_col;        //Column lit now, switched to plane 1 by the compare match
+
+
+/** Scrolling message state */
+static Message text;                    //Message being scrolled (copied from program memory)
+static bool text_active;                //TRUE while a message is scrolling
+static uint8_t text_shift;              //Strip bit shown on the first display row
+static uint8_t text_timer;              //Display ticks since the last scroll step
+
+
+/** Board frame being composed by draw_board, draw_ship and draw_cursor */
+static uint8_t pending_frame[DISPLAY_PLANES][DISPLAY_WIDTH];
+
+
+/** Board frame write instrumentation, since power on */
+static uint32_t render_pixels;          //Pixels whose level render_frame changed
+static uint32_t render_frames;          //Frames pushed by render_frame
+
+
+/** Show plane 1 for the rest of the lit column's slot */
+ISR(TIMER1_COMPB_vect)
 {
-    {2,6}, {3,5}, {4,4}, {3,3}, {2,2}, {1,1}, {0,0}, {0,0}, {0,0},
-};
+    ledmat_display_column(frame[1][lit_col], lit_col);
+}
 
 
-/** Bitmap for cross icon */
-static uint8_t cross_bitmap[DISPLAY_WIDTH] =
+/**
+Write a whole column of the frame buffer, one bitmap per brightness plane
+@param col column to write
+@param low column bitmap for plane 0 (bit 0 of each cell's level)
+@param high column bitmap for plane 1 (bit 1 of each cell's level)
+*/
+void blit_planes(uint8_t col, uint8_t low, uint8_t high)
 {
-    0x22, 0x14, 0x8, 0x14, 0x22
-};
+    frame[0][col] = low;
+    frame[1][col] = high;
+}
 
 
-/** Bitmap for ship icon */
-static uint8_t ship_bitmap[DISPLAY_WIDTH] =
+/**
+Write a whole column of the frame buffer at full brightness
+@param col column to write
+@param pattern column bitmap, one bit per row
+*/
+void blit_column(uint8_t col, uint8_t pattern)
 {
-    0x8, 0xA, 0x2A, 0x7F, 0x3E
-};
+    blit_planes(col, pattern, pattern);
+}
 
 
-/** Array of bitmaps for target animation (one bitmap = one step) */
-static uint8_t target_bitmap[NUM_TARGET_STEPS][DISPLAY_WIDTH] =
+/**
+Write every column of the frame buffer from a bitmap
+@param bitmap column bitmaps, DISPLAY_WIDTH bytes
+*/
+void blit_bitmap(const uint8_t* bitmap)
 {
-    {0x63, 0x49, 0x1C, 0x49, 0x63},
-    {0x63, 0x41, 0x0, 0x41, 0x63},
-};
+    uint8_t i;
+    for (i = 0; i < DISPLAY_WIDTH; i++) {
+        blit_column(i, bitmap[i]);
+    }
+}
 
 
+/**
+Blank the frame buffer and give it control of the display, stopping
+any scrolling message
+*/
+void blit_clear(void)
+{
+    uint8_t i;
+    for (i = 0; i < DISPLAY_WIDTH; i++) {
+        frame[0][i] = 0;
+        frame[1][i] = 0;
+    }
+    text_active = FALSE;
+}
+
 
 /**
-Initialise tinygl environment
+Blit the window of the scrolling message starting at text_shift. Each
+column is two strip bytes shifted into place, whatever the message.
 */
-void initialise_display(void)
+static void scroll_window(void)
 {
-    tinygl_init(DISPLAY_TASK_RATE);
-    tinygl_text_mode_set (TINYGL_TEXT_MODE_SCROLL);
-    tinygl_text_speed_set(SCROLL_SPEED);
-    tinygl_font_set (&font3x5_1);
-    tinygl_text_dir_set(TINYGL_TEXT_DIR_ROTATE);
-    tinygl_update();
+    uint8_t col;
+    const uint8_t* strip = text.strips + text_shift / 8;
+    for (col = 0; col < DISPLAY_WIDTH; col++) {
+        uint16_t bits = pgm_read_byte(strip) | (uint16_t) pgm_read_byte(strip + 1) << 8;
+        blit_column(col, (bits >> (text_shift % 8)) & ((1 << DISPLAY_HEIGHT) - 1));
+        strip += text.stride;
+    }
 }
 
 
 /**
-Draw ship currently being placed
+Scroll a pre-rendered message through the frame buffer until the next
+blit_clear
+@param msg message to scroll (program memory)
 */
-void draw_ship(void)
+void show_message(const Message* msg)
 {
-    Ship* ship = get_ship();
-    uint8_t i;
-    for (i = 0; i < ship->length; i++) {
-        if (ship->rot == HORIZ) {
-            tinygl_draw_point(tinygl_point(ship->pos.x + i, ship->pos.y), ON);
-        } else if (ship->rot == VERT) {
-            tinygl_draw_point(tinygl_point(ship->pos.x, ship->pos.y + i), ON);
-        }
+    blit_clear();
+    memcpy_P(&text, msg, sizeof(Message));
+    text_shift = text.length;
+    text_timer = 0;
+    text_active = TRUE;
+    scroll_window();
+}
+
+
+/**
+Refresh the display. Advances any scrolling message and lights the next
+frame buffer column, from plane 0 for the first PLANE_LOW_TICKS of its
+slot and plane 1 for the rest. Must be called at DISPLAY_TASK_RATE.
+*/
+void display_refresh(void)
+{
+    if (text_active && ++text_timer >= SCROLL_PERIOD) {
+        //Lower shifts show later text, wrapping onto the repeated start
+        text_timer = 0;
+        text_shift = text_shift > 1 ? text_shift - 1 : text.length;
+        scroll_window();
+    }
+
+    //The switch for the last column must not land on this one mid-change
+    TIMSK1 &= ~BIT(OCIE1B);
+    ledmat_display_column(frame[0][scan_col], scan_col);
+    lit_col = scan_col;
+    OCR1B = timer_get() + PLANE_LOW_TICKS;
+    TIFR1 = BIT(OCF1B);
+    TIMSK1 |= BIT(OCIE1B);
+
+    scan_col++;
+    if (scan_col == DISPLAY_WIDTH) {
+        scan_col = 0;
     }
 }
 
 
 /**
-Draw cursor on display
- */
-void draw_cursor(void)
+Initialise display environment
+*/
+void initialise_display(void)
 {
-    tinygl_point_t cursor = get_cursor();
-    tinygl_draw_point(cursor, ON);
+    ledmat_init();
 }
 
 
 /**
-Draw current board state.
-@param board_type specifies which board to display (this or target)
- */
-void draw_board(board_type_t board_type)
+Set cells of one board frame column to a brightness level
+@param col column to update
+@param cells column mask of cells to set
+@param level brightness level
+*/
+static void compose_cells(uint8_t col, uint8_t cells, brightness_t level)
 {
-    uint8_t *board = get_board(board_type);
-    int i, j;
-    for (i = 0; i < DISPLAY_WIDTH; i++) {
-        for (j = 0; j < DISPLAY_HEIGHT; j++) {
-            uint8_t is_on =  board[i] & BIT(j);
-            tinygl_draw_point(tinygl_point(i, j), is_on);
+    uint8_t plane;
+    for (plane = 0; plane < DISPLAY_PLANES; plane++) {
+        pending_frame[plane][col] &= ~cells;
+        if (level & BIT(plane)) {
+            pending_frame[plane][col] |= cells;
         }
     }
 }
 
 
 /**
-Display message indicating whether strike was successful
-@param last_result outcome of strike (hit or miss)
- */
-void display_result(strike_result_t last_result)
+Compose ship currently being placed into the board frame, at mid brightness
+@param board board state to draw.
+*/
+void draw_ship(Board* board)
 {
-    tinygl_clear();
-    if (last_result == MISS) {
-        tinygl_text(" MISS");
-    } else {
-        tinygl_text(" HIT  ");
+    Ship* ship = get_ship(board);
+    uint8_t i;
+    for (i = ship->pos.x; i < ship->pos.x + ship->span && i < DISPLAY_WIDTH; i++) {
+        compose_cells(i, ship->run & RUN_MASK(DISPLAY_HEIGHT), LEVEL_MID);
     }
 }
 
 
 /**
-Draw next frame for tick animation (if frames remaining).
-Animation is a tick drawn one dot at a time
-@return FALSE for failure (no frames remaining) or TRUE otherwise
+Compose cursor into the board frame, at full brightness (or off over a
+fully lit cell)
+@param board board state to draw.
  */
-int draw_tick_step(void)
+void draw_cursor(Board* board)
 {
-    static int step = 0;
-    if (step > NUM_TICK_POINTS) {
-        //animation finished
-        step = 0;
-        return FALSE;
+    tinygl_point_t cursor = get_cursor(board);
+    if (cursor.x < DISPLAY_WIDTH && cursor.y < DISPLAY_HEIGHT) {
+        uint8_t cell = BIT(cursor.y);
+        bool full = pending_frame[0][cursor.x] & pending_frame[1][cursor.x] & cell;
+        compose_cells(cursor.x, cell, full ? LEVEL_OFF : LEVEL_FULL);
     }
+}
+
 
-    //draw next step
-    tinygl_draw_point(tick_points[step], ON);
-    step++;
-    return TRUE;
+/**
+Start a board frame from the current board state (see render_frame).
+Placed ships are fully lit. Target board cells show their state as a
+level: misses dim, hits mid and the strike that sank each ship full.
+@param board board state to draw.
+@param board_type specifies which board to display (this or target)
+ */
+void draw_board(Board* board, board_type_t board_type)
+{
+    board_col_t *bitmap = get_board(board, board_type);
+    board_col_t *low = board_type == TARGET_BOARD ? get_target_low(board) : bitmap;
+    int i;
+    for (i = 0; i < DISPLAY_WIDTH; i++) {
+        //The target board's cell state bits are its brightness level bits
+        pending_frame[0][i] = i < BOARD_WIDTH ? low[i] & RUN_MASK(DISPLAY_HEIGHT) : 0;
+        pending_frame[1][i] = i < BOARD_WIDTH ? bitmap[i] & RUN_MASK(DISPLAY_HEIGHT) : 0;
+    }
 }
 
 
 /**
-Draw next frame for cross animation (if frames remaining)
-Animation is a cross that flashes.
-@return FALSE for failure (no frames remaining) or TRUE otherwise
+Push the board frame composed by draw_board, draw_ship and draw_cursor.
+Only columns that differ from the frame buffer are blitted.
  */
-int draw_cross_step(void)
-{
-    static int step = 0;
-    if (step >= NUM_CROSS_FLASHES * 2) {
-        //animation finished
-        step = 0;
-        return FALSE;
-
-    } else if (step % 2 == 0) {
-        //draw cross
-        int i, j;
-        for (i = 0; i < DISPLAY_WIDTH; i++) {
-            for (j = 0; j < DISPLAY_HEIGHT; j++) {
-                tinygl_draw_point(tinygl_point(i, j), cross_bitmap[i] >> j & 1);
-            }
+void render_frame(void)
+{
+    uint8_t i;
+    render_frames++;
+    for (i = 0; i < DISPLAY_WIDTH; i++) {
+        uint8_t changed = (pending_frame[0][i] ^ frame[0][i]) | (pending_frame[1][i] ^ frame[1][i]);
+        if (changed) {
+            blit_planes(i, pending_frame[0][i], pending_frame[1][i]);
+            render_pixels += __builtin_popcount(changed);
         }
-    } else {
-        //clear cross
-        tinygl_clear();
     }
+}
 
-    step++;
-    return TRUE;
+
+/**
+Clear the display ready for render_frame. Must be called when entering a
+phase that uses render_frame.
+ */
+void render_reset(void)
+{
+    blit_clear();
 }
 
 
 /**
-Draw next frame for target animation (looping).
-Animation consists of cycling through frame bitmaps
+Pixel writes made by render_frame since power on, counting each pixel
+whose level changed
+@return pixels changed
  */
-void draw_target_step(void)
+uint32_t get_render_pixels(void)
 {
-    static int step = 0;
-    tinygl_clear();
+    return render_pixels;
+}
 
-    int i, j;
-    for (i = 0; i < DISPLAY_WIDTH; i++) {
-        for (j = 0; j < DISPLAY_HEIGHT; j++) {
-            tinygl_draw_point(tinygl_point(i, j), target_bitmap[step][i] >> j & 1);
-        }
-    }
 
-    step = (step + 1) % NUM_TARGET_STEPS;
+/**
+Frames pushed by render_frame since power on. A full redraw writes
+DISPLAY_WIDTH * DISPLAY_HEIGHT pixels per frame.
+@return frames pushed
+ */
+uint32_t get_render_frames(void)
+{
+    return render_frames;
 }
 
 
 /**
-Draw next frame for ship animation (looping).
-Animation consists of ship logo moving right to left across screen, followed
-by user prompt 'Push To Start!'
+Display message indicating whether strike was successful
+@param last_result outcome of strike (hit or miss)
  */
- void draw_ship_step(void)
- {
-     static int step = 0;
-     static bool text_on = 0;
-     int i, j;
-
-     if (step == 2 * DISPLAY_HEIGHT + 1) {
-         // Transfer to scrolling text
-         tinygl_text("  PUSH TO START!");
-         text_on = TRUE;
-     } else if (step == 0) {
-         // Transfer to ship logo
-         tinygl_clear();
-         text_on = 0;
-     }
-
-     if (!text_on) {
-         // Draw ship step
-         for (i = 0; i < DISPLAY_WIDTH; i++) {
-             for (j = 0; j < DISPLAY_HEIGHT; j++) {
-                 tinygl_draw_point(tinygl_point(i, j), (ship_bitmap[i] << step) >> (j + DISPLAY_HEIGHT) & 1);
-             }
-         }
-     }
-
-     step = (step + 1) % NUM_SHIP_STEPS;
- }
+void display_result(strike_result_t last_result)
+{
+    if (last_result == MISS) {
+        show_message(&msg_miss);
+    } else if (last_result == SUNK || last_result == FLEET_SUNK) {
+        show_message(&msg_sunk);
+    } else {
+        show_message(&msg_hit);
+    }
+}
@@ -7,13 +7,19 @@
 **/
 
 #ifndef DISPLAY_HANDLER_H
-#define DISPLAY_HANDELR_H
+#define DISPLAY_HANDLER_H
 
 
 /** Required Library Modules */
 #include "board.h"
 #include "tinygl.h"
-#include "../fonts/font3x5_1.h"
+#include "ledmat.h"
+#include "timer.h"
+
+
+/** Application Modules */
+#include "idle.h"
+#include "messages.h"
 
 
 /** LED display macros */
@@ -26,80 +32,145 @@
 #define DISPLAY_TASK_RATE 300
 
 
-/** Animation parameters */
-#define TICK_STEP_RATE 10
-#define NUM_TICK_POINTS 9
+/**
+Brightness levels. Bit n of a level is held in frame buffer plane n. Each
+column's slot in the scan is split in thirds: plane 0 is shown for the
+first and plane 1 for the other two, so every level repeats at the full
+frame rate.
+*/
+typedef enum brightness {
+    LEVEL_OFF,                          //Never lit
+    LEVEL_DIM,                          //Lit for a third of the column slot
+    LEVEL_MID,                          //Lit for two thirds of the column slot
+    LEVEL_FULL,                         //Lit for the whole column slot
+} brightness_t;
+
 
-#define CROSS_STEP_RATE 2
-#define NUM_CROSS_FLASHES 2
+/** Frame buffer bit-planes, and the timer ticks plane 0 is shown for in each column slot */
+#define DISPLAY_PLANES 2
+#define PLANE_LOW_TICKS (IDLE_TIMER_RATE / DISPLAY_TASK_RATE / 3)
 
-#define TARGET_STEP_RATE 3
-#define NUM_TARGET_STEPS 2
 
-#define SHIP_STEP_RATE 4
-#define NUM_SHIP_STEPS 40
+/** Display ticks per message scroll step (SCROLL_SPEED is characters per 10 s) */
+#define SCROLL_PERIOD (DISPLAY_TASK_RATE * 10 / (SCROLL_SPEED * MESSAGE_CHAR_COLUMNS))
 
 
 /**
-Initialise tinygl environment
+Initialise display environment
 */
 void initialise_display(void);
 
 
 /**
-Draw ship currently being placed
+Write a whole column of the frame buffer at full brightness
+@param col column to write
+@param pattern column bitmap, one bit per row
+*/
+void blit_column(uint8_t col, uint8_t pattern);
+
+
+/**
+Write a whole column of the frame buffer, one bitmap per brightness plane
+@param col column to write
+@param low column bitmap for plane 0 (bit 0 of each cell's level)
+@param high column bitmap for plane 1 (bit 1 of each cell's level)
 */
-void draw_ship(void);
+void blit_planes(uint8_t col, uint8_t low, uint8_t high);
 
 
 /**
-Draw cursor
+Write every column of the frame buffer from a bitmap
+@param bitmap column bitmaps, DISPLAY_WIDTH bytes
+*/
+void blit_bitmap(const uint8_t* bitmap);
+
+
+/**
+Blank the frame buffer and give it control of the display, stopping
+any scrolling message
+*/
+void blit_clear(void);
+
+
+/**
+Scroll a pre-rendered message through the frame buffer until the next
+blit_clear
+@param msg message to scroll (program memory)
+*/
+void show_message(const Message* msg);
+
+
+/**
+Refresh the display. Advances any scrolling message and lights the next
+frame buffer column, from plane 0 for the first PLANE_LOW_TICKS of its
+slot and plane 1 for the rest. Must be called at DISPLAY_TASK_RATE.
+*/
+void display_refresh(void);
+
+
+/**
+Compose ship currently being placed into the board frame, at mid brightness
+@param board board state to draw.
+*/
+void draw_ship(Board* board);
+
+
+/**
+Compose cursor into the board frame, at full brightness (or off over a
+fully lit cell)
+@param board board state to draw.
  */
-void draw_cursor(void);
+void draw_cursor(Board* board);
 
 
 /**
-Draw current board state.
+Start a board frame from the current board state (see render_frame).
+Placed ships are fully lit. Target board cells show their state as a
+level: misses dim, hits mid and the strike that sank each ship full.
+@param board board state to draw.
 @param board_type specifies which board to display (this or target)
  */
-void draw_board(board_type_t board_type);
+void draw_board(Board* board, board_type_t board_type);
 
 
 /**
-Display message indicating whether strike was successful
-@param last_result outcome of strike (hit or miss)
+Push the board frame composed by draw_board, draw_ship and draw_cursor.
+Only columns that differ from the frame buffer are blitted. Changes are
+found by diffing the whole composed frame against the frame buffer, not
+by marking dirty cells where the board changes: the board is five columns,
+so the diff costs less than tracking would in every board mutation.
  */
-void display_result(strike_result_t last_result);
+void render_frame(void);
 
 
 /**
-Draw next frame for tick animation (if frames remaining).
-Animation is a tick drawn one dot at a time
-@return FALSE for failure (no frames remaining) or TRUE otherwise
+Clear the display ready for render_frame. Must be called when entering a
+phase that uses render_frame.
  */
-int draw_tick_step(void);
+void render_reset(void);
 
 
 /**
-Draw next frame for cross animation (if frames remaining)
-Animation is a cross that flashes.
-@return FALSE for failure (no frames remaining) or TRUE otherwise
+Pixel writes made by render_frame since power on, counting each pixel
+whose level changed
+@return pixels changed
  */
-int draw_cross_step(void);
+uint32_t get_render_pixels(void);
 
 
 /**
-Draw next frame for target animation (looping).
-Animation consists of cycling through frame bitmaps
+Frames pushed by render_frame since power on. A full redraw writes
+DISPLAY_WIDTH * DISPLAY_HEIGHT pixels per frame.
+@return frames pushed
  */
-void draw_target_step(void);
+uint32_t get_render_frames(void);
 
 
 /**
-Draw next frame for ship animation (looping).
-Animation consists of ship logo moving right to left across screen
+Display message indicating whether strike was successful
+@param last_result outcome of strike (hit or miss)
  */
-void draw_ship_step(void);
+void display_result(strike_result_t last_result);
 
 
 #endif
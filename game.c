@@ -12,20 +12,91 @@
 
 
 /** Game state variables */
-static phase_t game_phase;              //Current game phase
-static strike_result_t last_result;     //Result of this players last strike
-static int tick;                        //Game loop tick counter
-static int phase_tick;                  //Seperate tick counter for use within a phase
+static Game this_game;                  //State of the game hosted by this device
+static uint16_t loop_ticks;             //Free running game loop timestamp
 static spwm_t led_flicker;              //LED modulation interface
+static uint8_t timers_fired;            //Wheel timers that fired on this loop tick
+static uint32_t entropy = 1;            //Random pool, stirred with the timing of every input event
+
+
+/**
+Phase descriptor table. Each phase lists its enter action, the tasks
+that do any work in it and its display update rate. Board phases only
+change on input, and text scrolls inside display_refresh, so most phases
+update the display rarely.
+*/
+static const PhaseDesc phase_table[NUM_PHASES] = {
+    [SPLASH] = {enter_splash, TASK_NAVSWITCH | TASK_BUTTON, DISPLAY_ANIM_RATE},
+    [PLACING] = {enter_board, TASK_NAVSWITCH | TASK_BUTTON, NAVSWITCH_TASK_RATE},
+    [READY] = {enter_ready, TASK_NAVSWITCH | TASK_BUTTON | TASK_IR, DISPLAY_IDLE_RATE},
+    [AIM] = {enter_board, TASK_NAVSWITCH, NAVSWITCH_TASK_RATE},
+    [FIRE] = {NULL, TASK_IR, DISPLAY_IDLE_RATE},
+    [RESULT_GRAPHIC] = {enter_result_graphic, TASK_LED, DISPLAY_ANIM_RATE},
+    [RESULT] = {enter_result, TASK_BUTTON | TASK_GAME | TASK_LED, DISPLAY_IDLE_RATE},
+    [WAIT] = {enter_wait, TASK_IR, DISPLAY_ANIM_RATE},
+    [ENDRESULT] = {enter_endresult, TASK_GAME, DISPLAY_IDLE_RATE},
+    [PLAY_AGAIN] = {enter_play_again, TASK_BUTTON | TASK_IR, DISPLAY_IDLE_RATE},
+};
+
+
+/**
+Task table, in the order the tasks run within a tick. Each task names
+the wheel timers that wake it, or runs on every tick. There is always a
+tick due within one loop period for the display scan, so the navswitch
+and IR are polled on that wake rather than raising their own.
+*/
+static const TaskDesc task_table[] = {
+    {navswitch_task, TASK_NAVSWITCH, BIT(NAVSWITCH_TIMER)},
+    {button_task, TASK_BUTTON, BIT(BUTTON_TIMER)},
+    {game_task, TASK_GAME, BIT(PHASE_TIMER)},
+    {led_task, TASK_LED, WAKE_EVERY_TICK},
+    {link_task, TASK_ALWAYS, WAKE_EVERY_TICK},
+    {ir_task, TASK_IR, WAKE_EVERY_TICK},
+    {opponent_task, TASK_ALWAYS, WAKE_EVERY_TICK},
+    {draw_phase, TASK_ALWAYS, BIT(DISPLAY_TIMER)},
+    {display_task, TASK_ALWAYS, WAKE_EVERY_TICK},
+};
+#define NUM_TASKS (sizeof(task_table) / sizeof(task_table[0]))
+
+
+/** Profiler statistics block */
+static ProfileStat task_stats[NUM_TASKS]; //Time per run of each task_table entry
+static ProfileStat phase_stats[NUM_PHASES]; //Time per loop tick spent running tasks, by phase
+static bool skip_sample;                //TRUE to leave the current tick out of the statistics
+static uint16_t phase_misses[NUM_PHASES]; //Loop ticks that overran their deadline, by phase
+
+
+/**
+Run every task that is active in the current phase and due on this tick
+@param game game state to operate on.
+*/
+static void run_tasks(Game* game)
+{
+    uint8_t i;
+    for (i = 0; i < NUM_TASKS; i++) {
+        const TaskDesc* task = &task_table[i];
+        //Re-read the phase per task, as an earlier task may have changed it
+        bool active = task->flag == TASK_ALWAYS || (phase_table[game->phase].tasks & task->flag);
+        bool due = task->wake == WAKE_EVERY_TICK || (timers_fired & task->wake);
+        if (active && due) {
+            timer_tick_t start = timer_get();
+            task->run(game);
+            if (!skip_sample) {
+                profile_record(&task_stats[i], timer_get() - start);
+            }
+        }
+    }
+}
 
 
 /**
 Display related routines to be run before game loop
+@param game game state to operate on.
 */
-static void display_task_init(void)
+static void display_task_init(Game* game)
 {
     initialise_display();
-    change_phase(SPLASH);
+    change_phase(game, SPLASH);
 }
 
 
@@ -35,18 +106,19 @@ Navswitch related routines to be run before game loop
 static void navswitch_task_init(void)
 {
     navswitch_init();
+    wheel_start(NAVSWITCH_TIMER, NAVSWITCH_PERIOD, NAVSWITCH_PERIOD);
 }
 
 
 /**
 Game logic tasks to be run before game loop
+@param game game state to operate on.
 */
-static void game_task_init(void)
+static void game_task_init(Game* game)
 {
-    board_init();
-    game_phase = SPLASH;
-    tick = 0;
-    phase_tick = 0;
+    board_init(&game->board);
+    game->single_player = FALSE;
+    game->phase = SPLASH;
 }
 
 
@@ -56,6 +128,7 @@ Button related routines to be run before game loop
 static void button_task_init(void)
 {
     button_init();
+    wheel_start(BUTTON_TIMER, BUTTON_PERIOD, BUTTON_PERIOD);
 }
 
 
@@ -76,25 +149,34 @@ IR related routines to be run before game loop
 */
 static void ir_task_init(void)
 {
-    ir_uart_init();
+    ir_link_init();
 }
 
 
 /**
 Handles navswitch tasks dependant on the game phase.
+@param game game state to operate on.
 */
-static void navswitch_task(void)
+static void navswitch_task(Game* game)
 {
     dir_t dir;
-    switch (game_phase) {
+    switch (game->phase) {
+
+        case SPLASH :
+            /** Navswitch push skips placing, with the fleet placed at random */
+            if (get_navswitch_dir() == DIR_DOWN) {
+                auto_place(&game->board, &entropy);
+                change_phase(game, READY);
+            }
+            break;
 
         case PLACING :
             /** Handle navswitch events for player moving/placing ships on board */
             dir = get_navswitch_dir();
             if (dir >= DIR_N && dir <= DIR_W){
-                move_ship(dir);
-            } else if (dir == DIR_DOWN && place_ship() && !next_ship()) {
-                change_phase(READY);
+                move_ship(&game->board, dir);
+            } else if (dir == DIR_DOWN && place_ship(&game->board) && !next_ship(&game->board)) {
+                change_phase(game, READY);
             }
             break;
 
@@ -102,10 +184,19 @@ static void navswitch_task(void)
             /** Handle navswitch events for player moving/firing target cursor */
             dir = get_navswitch_dir();
             if (dir >= DIR_N && dir <= DIR_W) {
-                move_cursor(dir);
-            } else if (dir == DIR_DOWN && is_valid_strike()) {
-                ir_send_strike(get_cursor());
-                change_phase(FIRE);
+                move_cursor(&game->board, dir);
+            } else if (dir == DIR_DOWN && is_valid_strike(&game->board)) {
+                opponent_send_strike(game, get_cursor(&game->board));
+                change_phase(game, FIRE);
+            }
+            break;
+
+        case READY :
+            /** Navswitch push starts a single player game against the AI */
+            if (get_navswitch_dir() == DIR_DOWN) {
+                game->single_player = TRUE;
+                ai_init(&game->opponent, random_next(&entropy));
+                change_phase(game, AIM);
             }
             break;
 
@@ -117,32 +208,40 @@ static void navswitch_task(void)
 
 /**
 Handles button tasks dependant on the current phase.
+@param game game state to operate on.
 */
-static void button_task(void)
+static void button_task(Game* game)
 {
     button_update();
     if (button_push_event_p(BUTTON1)) {
-        switch (game_phase) {
+        stir_entropy();
+        switch (game->phase) {
             case SPLASH :
-                change_phase(PLACING);
+                /** Holding the navswitch north turns the button into a stats dump */
+                if (navswitch_down_p(NAVSWITCH_NORTH)) {
+                    stats_dump();
+                } else {
+                    change_phase(game, PLACING);
+                }
                 break;
 
             case PLACING :
-                rotate_ship();
+                rotate_ship(&game->board);
                 break;
 
             case READY :
+                game->single_player = FALSE;
                 ir_send_status(PLAYER_TWO_S);
-                change_phase(AIM);
+                change_phase(game, AIM);
                 break;
 
             case RESULT :
-                change_phase(WAIT);
+                leave_result(game);
                 break;
 
             case PLAY_AGAIN :
-                ir_send_status(PLAY_AGAIN_S);
-                reset_game();
+                opponent_send_status(game, PLAY_AGAIN_S);
+                reset_game(game);
                 break;
 
             default :
@@ -153,139 +252,133 @@ static void button_task(void)
 
 
 /**
-Handles blue LED tasks dependant on the game phase.
+Handles blue LED flashing while a strike result is shown. The LED is
+otherwise set by each phase's enter action.
+@param game game state to operate on.
 */
-static void led_task(void)
+static void led_task(Game* game)
 {
-    switch (game_phase) {
-
-        case PLACING :
-        case AIM :
-            /** LED on */
-            led_set(LED1, 1);
-            break;
-
-        case SPLASH :
-        case READY :
-        case WAIT :
-            /** LED off */
-            led_set(LED1, 0);
-            break;
-
-        case RESULT :
-        case RESULT_GRAPHIC :
-            /** LED flashing */
-            last_result == HIT ? led_set(LED1, spwm_update(&led_flicker)) : led_set(LED1, 0);
-            break;
-
-        case ENDRESULT :
-            /** LED on for winner */
-            is_winner() ? led_set(LED1, 1) : led_set(LED1, 0);
-            break;
-
-        default :
-            break;
-    }
+    IS_HIT_RESULT(game->last_result) ? led_set(LED1, spwm_update(&led_flicker)) : led_set(LED1, 0);
 }
 
 
 /**
-Handles display tasks dependant on the current game phase.
+Updates the display contents dependant on the current game phase.
+@param game game state to operate on.
 */
-static void display_task(void)
+static void draw_phase(Game* game)
 {
-    switch (game_phase) {
+    switch (game->phase) {
 
         case SPLASH :
-            /** Draw next splash animation step (ship + text) */
-            phase_tick += 1;
-            if (phase_tick > LOOP_RATE / SHIP_STEP_RATE) {
-                phase_tick = 0;
-                draw_ship_step();
+            /** Draw due splash animation frames (ship, then cue for text) */
+            if (anim_update(loop_ticks) == ANIM_CUED) {
+                show_message(&msg_start);
             }
             break;
 
         case PLACING :
             /** Draw board plus ship to be placed */
-            tinygl_clear();
-            draw_board(THIS_BOARD);
-            draw_ship();
+            draw_board(&game->board, THIS_BOARD);
+            draw_ship(&game->board);
+            render_frame();
             break;
 
         case AIM :
             /** Draw board plus target cursor */
-            tinygl_clear();
-            draw_board(TARGET_BOARD);
-            draw_cursor();
+            draw_board(&game->board, TARGET_BOARD);
+            draw_cursor(&game->board);
+            render_frame();
             break;
 
         case RESULT_GRAPHIC :
-            /** Draw appropriate result animation step, until all steps are complete */
-            phase_tick += 1;
-
-            if (last_result == HIT && phase_tick > LOOP_RATE / TICK_STEP_RATE) {
-                phase_tick = 0;
-                if (!draw_tick_step()) {
-                    change_phase(RESULT);
-                }
-
-            } else if (last_result == MISS && phase_tick > LOOP_RATE / CROSS_STEP_RATE) {
-                phase_tick = 0;
-                if (!draw_cross_step()) {
-                    change_phase(RESULT);
-                }
+            /** Draw due result animation frames, until the animation ends */
+            if (anim_update(loop_ticks) == ANIM_FINISHED) {
+                change_phase(game, RESULT);
             }
             break;
 
         case WAIT :
-        case TRANSFER :
-            /** Draw looping target animation step */
-            phase_tick += 1;
-            if (phase_tick > LOOP_RATE / TARGET_STEP_RATE) {
-                phase_tick = 0;
-                draw_target_step();
-            }
+            /** Draw due frames of looping target animation */
+            anim_update(loop_ticks);
             break;
 
         default :
             break;
     }
+}
+
 
-    tinygl_update();
+/**
+Scans the LED matrix. The contents are updated separately by draw_phase,
+at the phase's display rate.
+@param game game state to operate on.
+*/
+static void display_task(Game* game)
+{
+    (void) game;
+    display_refresh();
+}
+
+
+/**
+Runs the AI opponent's share of the tick.
+@param game game state to operate on.
+*/
+static void opponent_task(Game* game)
+{
+    ai_task(&game->opponent);
+}
+
+
+/**
+Services the IR link in every phase, so frames from the other player are
+acknowledged and our own are sent and retried.
+@param game game state to operate on.
+*/
+static void link_task(Game* game)
+{
+    (void) game;
+    ir_link_task();
 }
 
 
 /**
 Runs any IR tasks dependant on the current game phase.
+@param game game state to operate on.
 */
-static void ir_task(void)
+static void ir_task(Game* game)
 {
     states status;
     uint8_t position;
 
-    switch (game_phase) {
+    switch (game->phase) {
 
         case READY :
             /** Await assignment to player 2 from other player pressing button*/
             if (ir_get_status() == PLAYER_TWO_S) {
-                change_phase(WAIT);
+                game->single_player = FALSE;
+                change_phase(game, WAIT);
             }
             break;
 
         case FIRE :
             /** Await result of strike*/
-            status = ir_get_status();
+            status = opponent_get_status(game);
 
             switch (status) {
                 case HIT_S :
-                    add_hit();
-                    last_result = HIT;
-                    change_phase(RESULT_GRAPHIC);
+                case SUNK_S :
+                case FLEET_SUNK_S :
+                    game->last_result = ir_decode_result(status);
+                    add_hit(&game->board, game->last_result);
+                    change_phase(game, RESULT_GRAPHIC);
                     break;
 
                 case MISS_S :
-                    last_result = MISS;
-                    change_phase(RESULT_GRAPHIC);
+                    game->last_result = MISS;
+                    add_miss(&game->board);
+                    change_phase(game, RESULT_GRAPHIC);
                     break;
 
                 default :
@@ -294,33 +387,23 @@ static void ir_task(void)
             break;
 
         case WAIT :
-            /** Await strike position, calculate result once received */
-            position = ir_get_position();
+            /** Await strike position, reply with its result and take our turn (or lose).
+                Other messages, such as PLAY_AGAIN_S, decode off the board and are ignored. */
+            position = opponent_get_position(game);
             if (position != NO_POSITION) {
                 tinygl_point_t shot = ir_decode_strike(position);
-                if (is_hit(shot)) {
-                    ir_send_status(HIT_S);
-                } else {
-                    ir_send_status(MISS_S);
+                if ((uint8_t) shot.x < BOARD_WIDTH && (uint8_t) shot.y < BOARD_HEIGHT) {
+                    strike_result_t result = is_hit(&game->board, shot);
+                    opponent_send_status(game, ir_encode_result(result));
+                    change_phase(game, result == FLEET_SUNK ? ENDRESULT : AIM);
                 }
-                change_phase(TRANSFER);
-            }
-            break;
-
-        case TRANSFER :
-            /** Await decision for game-over / play-on */
-            status = ir_get_status();
-            if (status == LOSER_S) {
-                change_phase(ENDRESULT);
-            } else if (status == PLAYON_S) {
-                change_phase(AIM);
             }
             break;
 
         case PLAY_AGAIN :
             /** Await new game signal from other player */
-            if(ir_get_status() == PLAY_AGAIN_S){
-                reset_game();
+            if(opponent_get_status(game) == PLAY_AGAIN_S){
+                reset_game(game);
             }
             break;
 
@@ -331,34 +414,74 @@ static void ir_task(void)
 
 
 /**
-Handles switching between time oriented game phases.
+Send a status code to the other player (over IR or to the AI).
+@param game game state to operate on.
+@param status status code to be transmitted
+*/
+static void opponent_send_status(Game* game, states status)
+{
+    if (game->single_player) {
+        ai_send_status(&game->opponent, status);
+    } else {
+        ir_send_status(status);
+    }
+}
+
+
+/**
+Get status code from the other player (over IR or from the AI).
+@param game game state to operate on.
+@return received status code (or special NORESPONSE_S code if nothing received)
+*/
+static states opponent_get_status(Game* game)
+{
+    return game->single_player ? ai_get_status(&game->opponent) : ir_get_status();
+}
+
+
+/**
+Send a strike position to the other player (over IR or to the AI).
+@param game game state to operate on.
+@param pos position of strike
+*/
+static void opponent_send_strike(Game* game, tinygl_point_t pos)
+{
+    if (game->single_player) {
+        ai_send_strike(&game->opponent, pos);
+    } else {
+        ir_send_strike(pos);
+    }
+}
+
+
+/**
+Get strike position from the other player (over IR or from the AI).
+@param game game state to operate on.
+@return received encoded position, or special NO_POSITION if nothing received
 */
-static void game_task(void)
+static uint8_t opponent_get_position(Game* game)
 {
-    switch(game_phase) {
+    return game->single_player ? ai_get_position(&game->opponent) : ir_get_position();
+}
+
+
+/**
+Handles switching between time oriented game phases. Runs when the
+phase timer fires.
+@param game game state to operate on.
+*/
+static void game_task(Game* game)
+{
+    switch(game->phase) {
 
         case RESULT :
-            /** After set duration, check if game over and move to appropriate phase */
-            phase_tick += 1;
-            if (phase_tick > LOOP_RATE * RESULT_DURATION) {
-                phase_tick = 0;
-                if (is_winner()) {
-                    ir_send_status(LOSER_S);
-                    change_phase(ENDRESULT);
-                } else {
-                    ir_send_status(PLAYON_S);
-                    change_phase(WAIT);
-                }
-            }
+            /** After set duration, move to the game over or holding phase */
+            leave_result(game);
             break;
 
         case ENDRESULT :
             /** After set duration, move to 'play again' prompt */
-            phase_tick += 1;
-            if (phase_tick > LOOP_RATE * GAMEOVER_DURATION) {
-                phase_tick = 0;
-                change_phase(PLAY_AGAIN);
-            }
+            change_phase(game, PLAY_AGAIN);
             break;
 
         default :
@@ -368,55 +491,136 @@ static void game_task(void)
 
 
 /**
-Swaps states to the provided game phase.
-@param new_phase game state to transfer into.
+Leave the strike result screen, for the game over screen if that strike
+sank the last ship, otherwise to await the other player's strike. The
+other player already knows which from the strike result.
+@param game game state to operate on.
 */
-void change_phase(phase_t new_phase)
+static void leave_result(Game* game)
 {
-    switch (new_phase) {
+    change_phase(game, is_winner(&game->board) ? ENDRESULT : WAIT);
+}
 
-        case SPLASH :
-            tinygl_clear();
-            break;
 
-        case READY :
-            tinygl_clear();
-            tinygl_text("  READY?");
-            break;
+/**
+Enter action for SPLASH: start the splash animation, LED off.
+@param game game state to operate on.
+*/
+static void enter_splash(Game* game)
+{
+    (void) game;
+    anim_start(&anim_ship, loop_ticks);
+    led_set(LED1, 0);
+}
 
-        case RESULT_GRAPHIC :
-            tinygl_clear();
-            break;
 
-        case RESULT :
-            tinygl_clear();
-            display_result(last_result); //in display_handler
-            break;
+/**
+Enter action for PLACING and AIM: clear the display for the board, LED on.
+@param game game state to operate on.
+*/
+static void enter_board(Game* game)
+{
+    (void) game;
+    render_reset();
+    led_set(LED1, 1);
+}
 
-        case WAIT :
-            tinygl_clear();
-            break;
 
-        case ENDRESULT :
-            tinygl_clear();
-            if (game_phase == RESULT) {
-                tinygl_text("  YOU WIN!  ");
-            } else {
-                tinygl_text("  YOU LOSE! ");
-            }
-            break;
+/**
+Enter action for READY: prompt for the first turn, LED off.
+@param game game state to operate on.
+*/
+static void enter_ready(Game* game)
+{
+    (void) game;
+    show_message(&msg_ready);
+    led_set(LED1, 0);
+}
 
-        case PLAY_AGAIN :
-            tinygl_clear();
-            tinygl_text("  PUSH TO PLAY AGAIN!");
-            break;
 
-        default :
-            break;
+/**
+Enter action for RESULT_GRAPHIC: start the hit or miss animation.
+@param game game state to operate on.
+*/
+static void enter_result_graphic(Game* game)
+{
+    anim_start(IS_HIT_RESULT(game->last_result) ? &anim_tick : &anim_cross, loop_ticks);
+}
+
+
+/**
+Enter action for RESULT: show the hit or miss message.
+@param game game state to operate on.
+*/
+static void enter_result(Game* game)
+{
+    display_result(game->last_result); //in display_handler
+    wheel_start(PHASE_TIMER, RESULT_TICKS, 0);
+}
+
+
+/**
+Enter action for WAIT: start the holding animation, LED off.
+@param game game state to operate on.
+*/
+static void enter_wait(Game* game)
+{
+    (void) game;
+    anim_start(&anim_target, loop_ticks);
+    led_set(LED1, 0);
+}
+
+
+/**
+Enter action for ENDRESULT: show the game over message, LED on for winner.
+Must run before the phase changes, as the previous phase tells who won.
+@param game game state to operate on.
+*/
+static void enter_endresult(Game* game)
+{
+    if (game->phase == RESULT) {
+        show_message(&msg_win);
+    } else {
+        show_message(&msg_lose);
+    }
+    led_set(LED1, is_winner(&game->board));
+    wheel_start(PHASE_TIMER, GAMEOVER_TICKS, 0);
+}
+
+
+/**
+Enter action for PLAY_AGAIN: prompt for a new game.
+@param game game state to operate on.
+*/
+static void enter_play_again(Game* game)
+{
+    (void) game;
+    show_message(&msg_play_again);
+}
+
+
+/**
+Swaps states to the provided game phase, running its enter action.
+@param game game state to operate on.
+@param new_phase game state to transfer into.
+*/
+void change_phase(Game* game, phase_t new_phase)
+{
+    //Deadlines belong to the phase being left
+    wheel_stop(PHASE_TIMER);
+    timers_fired &= ~BIT(PHASE_TIMER);
+
+    if (phase_table[new_phase].enter != NULL) {
+        phase_table[new_phase].enter(game);
+    }
+
+    if (phase_table[new_phase].display_rate != DISPLAY_IDLE_RATE) {
+        wheel_start(DISPLAY_TIMER, 1, LOOP_RATE / phase_table[new_phase].display_rate);
+    } else {
+        wheel_stop(DISPLAY_TIMER);
     }
 
-    phase_tick = 0;
-    game_phase = new_phase;
+    game->phase = new_phase;
 }
 
 
@@ -425,25 +629,131 @@ Get latest navswitch event and return associated direction
 */
 dir_t get_navswitch_dir(void)
 {
+    dir_t dir = DIR_NONE;
     navswitch_update();
-    if (navswitch_push_event_p (NAVSWITCH_WEST)) return DIR_W;
-    if (navswitch_push_event_p (NAVSWITCH_EAST)) return DIR_E;
-    if (navswitch_push_event_p (NAVSWITCH_NORTH)) return DIR_N;
-    if (navswitch_push_event_p (NAVSWITCH_SOUTH)) return DIR_S;
-    if (navswitch_push_event_p (NAVSWITCH_PUSH)) return DIR_DOWN;
-    return DIR_NONE;
+    if (navswitch_push_event_p (NAVSWITCH_WEST)) dir = DIR_W;
+    else if (navswitch_push_event_p (NAVSWITCH_EAST)) dir = DIR_E;
+    else if (navswitch_push_event_p (NAVSWITCH_NORTH)) dir = DIR_N;
+    else if (navswitch_push_event_p (NAVSWITCH_SOUTH)) dir = DIR_S;
+    else if (navswitch_push_event_p (NAVSWITCH_PUSH)) dir = DIR_DOWN;
+    if (dir != DIR_NONE) {
+        stir_entropy();
+    }
+    return dir;
+}
+
+
+/**
+Stir the time of an input event into the random pool. The loop tick
+count and timer value together give a 32-bit sample, and the human
+timing of successive events keeps the pool from repeating between games.
+*/
+static void stir_entropy(void)
+{
+    random_stir(&entropy, (uint32_t) loop_ticks << 16 | timer_get());
+}
+
+
+/**
+Send one character of a stats dump over IR.
+@param c character to send
+*/
+static void stats_put(char c)
+{
+    ir_uart_putc(c);
+}
+
+
+/**
+Scale a count over loop ticks to a rate per second. The count is divided
+before it is scaled, so this cannot overflow while ticks < 2^32 / LOOP_RATE.
+@param count events counted
+@param ticks loop ticks they were counted over, nonzero
+@return events per second
+*/
+static uint32_t per_second(uint32_t count, uint32_t ticks)
+{
+    return count / ticks * LOOP_RATE + count % ticks * LOOP_RATE / ticks;
+}
+
+
+/**
+Send the profiler statistics over IR, one line per task (in task_table
+order) and per phase (in phase_t order), then one line per counter (see
+the README). Frames still queued by the IR link are sent first, so the
+dump never lands inside one. Sending blocks for a while, so
+this tick is left out of the statistics and loop pacing restarts after.
+*/
+static void stats_dump(void)
+{
+    uint32_t board_ticks = phase_stats[PLACING].count + phase_stats[AIM].count;
+    uint16_t counts[IDLE_JITTER_BUCKETS > NUM_PHASES ? IDLE_JITTER_BUCKETS : NUM_PHASES];
+    uint8_t i;
+
+    ir_link_flush();
+    profile_dump(stats_put, "task", task_stats, NUM_TASKS);
+    profile_dump(stats_put, "phase", phase_stats, NUM_PHASES);
+    profile_dump_value(stats_put, "ai max", ai_worst_cycles(&this_game.opponent));
+    profile_dump_value(stats_put, "res", PROFILE_CYCLES_PER_TICK);
+    profile_dump_value(stats_put, "misses", idle_get_misses());
+    for (i = 0; i < NUM_PHASES; i++) {
+        counts[i] = get_phase_misses(i);
+    }
+    profile_dump_counts(stats_put, "miss", counts, NUM_PHASES);
+    for (i = 0; i < IDLE_JITTER_BUCKETS; i++) {
+        counts[i] = idle_get_jitter(i);
+    }
+    profile_dump_counts(stats_put, "jitter", counts, IDLE_JITTER_BUCKETS);
+    profile_dump_value(stats_put, "sleep avg %", idle_get_sleep_average());
+    profile_dump_value(stats_put, "sleep %", idle_get_sleep_percent());
+    for (i = 0; i < NUM_PHASES; i++) {
+        counts[i] = get_phase_load(i);
+    }
+    profile_dump_counts(stats_put, "load", counts, NUM_PHASES);
+    if (board_ticks > 0) {
+        //Per second of PLACING and AIM, the phases drawn by render_frame
+        uint32_t frames = get_render_frames();
+        profile_dump_value(stats_put, "board px/s", per_second(get_render_pixels(), board_ticks));
+        profile_dump_value(stats_put, "redraw px/s",
+                           per_second(frames, board_ticks) * (DISPLAY_WIDTH * DISPLAY_HEIGHT));
+    }
+    skip_sample = TRUE;
+    idle_restart();
+}
+
+
+/**
+CPU usage of the game loop while in a phase, since power on. Resolution is
+one timer tick per loop, rounded down.
+@param phase game phase to report
+@return percentage of each loop tick spent running tasks
+*/
+uint8_t get_phase_load(phase_t phase)
+{
+    return profile_average(&phase_stats[phase]) / (IDLE_TIMER_RATE / LOOP_RATE);
+}
+
+
+/**
+Number of loop ticks that overran the LOOP_RATE deadline while in a
+phase, since power on. Loop jitter is available from idle_get_jitter.
+@param phase game phase to report
+@return missed deadlines
+*/
+uint16_t get_phase_misses(phase_t phase)
+{
+    return phase_misses[phase];
 }
 
 
 /**
 Re-initializes states to re-start game.
+@param game game state to operate on.
 */
-void reset_game(void)
+void reset_game(Game* game)
 {
-    tick = 0;
-    phase_tick = 0;
-    board_init();
-    change_phase(PLACING);
+    board_init(&game->board);
+    change_phase(game, PLACING);
 }
 
 
@@ -452,30 +762,41 @@ Main game function
 */
 int main (void)
 {
+    phase_t phase;
+
     /** Initialisation routines */
     system_init ();
+    wheel_init ();
 
-    display_task_init ();
+    display_task_init (&this_game);
     button_task_init ();
-    game_task_init ();
+    game_task_init (&this_game);
     navswitch_task_init();
     led_task_init();
     ir_task_init();
 
-    pacer_init(LOOP_RATE);
+    profile_reset(task_stats, NUM_TASKS);
+    profile_reset(phase_stats, NUM_PHASES);
+    idle_init(LOOP_RATE);
+    phase = this_game.phase;
 
     /** Main game loop */
     while(1) {
-        pacer_wait();
-        tick += 1;
-        if (tick > LOOP_RATE / NAVSWITCH_TASK_RATE) {
-            tick = 0;
-            navswitch_task();
+        timer_tick_t start;
+
+        //A missed deadline belongs to the phase the overrunning tick started in
+        if (idle_wait()) {
+            phase_misses[phase]++;
+        }
+        start = timer_get();
+        phase = this_game.phase;
+        loop_ticks += 1;
+        timers_fired = wheel_tick();
+        run_tasks(&this_game);
+
+        if (!skip_sample) {
+            profile_record(&phase_stats[phase], timer_get() - start);
         }
-        button_task();
-        game_task();
-        led_task();
-        ir_task();
-        display_task();
+        skip_sample = FALSE;
     }
 }
@@ -19,27 +19,54 @@
 #include "led.h"
 #include "tinygl.h"
 #include "spwm.h"
-#include "pacer.h"
+#include "timer.h"
 
 
 /** Application Modules */
 #include "board.h"
 #include "display_handler.h"
+#include "animation.h"
 #include "ir_handler.h"
+#include "ai.h"
+#include "wheel.h"
+#include "idle.h"
+#include "profile.h"
 
 
 /* Define polling rates in Hz.  */
 #define NAVSWITCH_TASK_RATE 20
+#define BUTTON_TASK_RATE 100
 #define LOOP_RATE 300
 
 
+/* Define display update rates in Hz (the LED matrix is always scanned at DISPLAY_TASK_RATE).  */
+#define DISPLAY_ANIM_RATE 60            //Phases playing animations
+#define DISPLAY_IDLE_RATE 0             //Phases whose frame only changes on entry (or scrolls itself)
+
+
+/* Define task flags for the phase table.  */
+#define TASK_ALWAYS 0                   //Task is active in every phase
+#define TASK_NAVSWITCH BIT(0)
+#define TASK_BUTTON BIT(1)
+#define TASK_GAME BIT(2)
+#define TASK_LED BIT(3)
+#define TASK_IR BIT(4)
+
+
 /* Define aesthetic parameters.  */
-#define RESULT_DURATION 2.2             //Duration of HIT/MISS screen (seconds)
+#define RESULT_DURATION_MS 2200        //Duration of HIT/MISS screen (milliseconds)
 #define GAMEOVER_DURATION 9             //Duration of WIN/LOSE screen (seconds)
 #define LED_PERIOD (LOOP_RATE / 4)      //LED time on per duty cycle (clicks)
 #define LED_DUTY (LOOP_RATE / 6)        //LED length of duty cycle (clicks)
 
 
+/* Define timer wheel periods in loop ticks.  */
+#define NAVSWITCH_PERIOD (LOOP_RATE / NAVSWITCH_TASK_RATE)
+#define BUTTON_PERIOD (LOOP_RATE / BUTTON_TASK_RATE)
+#define RESULT_TICKS ((uint32_t) LOOP_RATE * RESULT_DURATION_MS / 1000)
+#define GAMEOVER_TICKS (LOOP_RATE * GAMEOVER_DURATION)
+
+
 /** Define game phases */
 typedef enum phase {
     SPLASH,                             //Used for first display message.
@@ -49,17 +76,60 @@ typedef enum phase {
     FIRE,                               //Strike location selected, sending IR to other player.
     RESULT_GRAPHIC,                     //Display an animated graphic representing hit or miss.
     RESULT,                             //Hit or miss message shown to active player
-    TRANSFER,                           //Next turn intermediate phase
     WAIT,                               //Player 2 phase, inactive state waiting for IR.
     ENDRESULT,                          //Game over message
     PLAY_AGAIN,                         //Prompts user for restart
+    NUM_PHASES,                         //Number of phases (not a phase)
 } phase_t;
 
 
+/**
+Structure definition for the state of one game. Every phase routine
+operates on an explicit instance; the device build keeps a single one.
+*/
+typedef struct game {
+    phase_t phase;                      //Current game phase
+    strike_result_t last_result;        //Result of this players last strike
+    Board board;                        //This player's boards, ships and cursor
+    bool single_player;                 //TRUE when playing the AI instead of over IR
+    Ai opponent;                        //AI opponent (single player only)
+} Game;
+
+
+/** Timer wheel timers used by the game */
+typedef enum game_timer {
+    PHASE_TIMER,                        //Timeout of the current phase (stopped on phase change)
+    NAVSWITCH_TIMER,                    //Navswitch polling
+    BUTTON_TIMER,                       //Button polling
+    DISPLAY_TIMER,                      //Display updates at the phase's display rate
+} game_timer_t;
+
+
+/** Wake mask for tasks that run on every tick */
+#define WAKE_EVERY_TICK 0
+
+
+/** Structure definition for a task run by the scheduler */
+typedef struct task_desc {
+    void (*run)(Game* game);            //Task routine
+    uint8_t flag;                       //TASK_ flag checked against the phase's tasks, or TASK_ALWAYS
+    uint8_t wake;                       //Mask of wheel timers that wake the task, or WAKE_EVERY_TICK
+} TaskDesc;
+
+
+/** Structure definition for the description of one game phase */
+typedef struct phase_desc {
+    void (*enter)(Game* game);          //Enter action, run before the phase changes (NULL if none)
+    uint8_t tasks;                      //Tasks that do any work in this phase (TASK_ flags)
+    uint8_t display_rate;               //Display update rate (Hz), or DISPLAY_IDLE_RATE
+} PhaseDesc;
+
+
 /**
 Display related routines to be run before game loop
+@param game game state to operate on.
 */
-static void display_task_init(void);
+static void display_task_init(Game* game);
 
 
 /**
@@ -70,8 +140,9 @@ static void navswitch_task_init(void);
 
 /**
 Game logic tasks to be run before game loop
+@param game game state to operate on.
 */
-static void game_task_init(void);
+static void game_task_init(Game* game);
 
 
 /**
@@ -94,51 +165,189 @@ static void ir_task_init(void);
 
 /**
 Handles navswitch tasks dependant on the game phase.
+@param game game state to operate on.
 */
-static void navswitch_task(void);
+static void navswitch_task(Game* game);
 
 
 /**
 Handles button tasks dependant on the current phase.
+@param game game state to operate on.
+*/
+static void button_task(Game* game);
+
+
+/**
+Handles blue LED flashing while a strike result is shown. The LED is
+otherwise set by each phase's enter action.
+@param game game state to operate on.
 */
-static void button_task(void);
+static void led_task(Game* game);
 
 
 /**
-Handles blue LED tasks dependant on the game phase.
+Updates the display contents dependant on the current game phase.
+@param game game state to operate on.
 */
-static void led_task(void);
+static void draw_phase(Game* game);
 
 
 /**
-Handles display tasks dependant on the current game phase.
+Scans the LED matrix. The contents are updated separately by draw_phase,
+at the phase's display rate.
+@param game game state to operate on.
 */
-static void display_task(void);
+static void display_task(Game* game);
+
+
+/**
+Runs the AI opponent's share of the tick.
+@param game game state to operate on.
+*/
+static void opponent_task(Game* game);
+
+
+/**
+Run every task that is active in the current phase and due on this tick
+@param game game state to operate on.
+*/
+static void run_tasks(Game* game);
+
+
+/**
+Services the IR link in every phase, so frames from the other player are
+acknowledged and our own are sent and retried.
+@param game game state to operate on.
+*/
+static void link_task(Game* game);
 
 
 /**
 Runs any IR tasks dependant on the current game phase.
+@param game game state to operate on.
+*/
+static void ir_task(Game* game);
+
+
+/**
+Send a status code to the other player (over IR or to the AI).
+@param game game state to operate on.
+@param status status code to be transmitted
+*/
+static void opponent_send_status(Game* game, states status);
+
+
+/**
+Get status code from the other player (over IR or from the AI).
+@param game game state to operate on.
+@return received status code (or special NORESPONSE_S code if nothing received)
+*/
+static states opponent_get_status(Game* game);
+
+
+/**
+Send a strike position to the other player (over IR or to the AI).
+@param game game state to operate on.
+@param pos position of strike
+*/
+static void opponent_send_strike(Game* game, tinygl_point_t pos);
+
+
+/**
+Get strike position from the other player (over IR or from the AI).
+@param game game state to operate on.
+@return received encoded position, or special NO_POSITION if nothing received
+*/
+static uint8_t opponent_get_position(Game* game);
+
+
+/**
+Handles switching between time oriented game phases. Runs when the
+phase timer fires.
+@param game game state to operate on.
+*/
+static void game_task(Game* game);
+
+
+/**
+Leave the strike result screen, for the game over screen if that strike
+sank the last ship, otherwise to await the other player's strike. The
+other player already knows which from the strike result.
+@param game game state to operate on.
+*/
+static void leave_result(Game* game);
+
+
+/**
+Enter action for SPLASH: start the splash animation, LED off.
+@param game game state to operate on.
+*/
+static void enter_splash(Game* game);
+
+
+/**
+Enter action for PLACING and AIM: clear the display for the board, LED on.
+@param game game state to operate on.
+*/
+static void enter_board(Game* game);
+
+
+/**
+Enter action for READY: prompt for the first turn, LED off.
+@param game game state to operate on.
+*/
+static void enter_ready(Game* game);
+
+
+/**
+Enter action for RESULT_GRAPHIC: start the hit or miss animation.
+@param game game state to operate on.
+*/
+static void enter_result_graphic(Game* game);
+
+
+/**
+Enter action for RESULT: show the hit or miss message.
+@param game game state to operate on.
 */
-static void ir_task(void);
+static void enter_result(Game* game);
 
 
 /**
-Handles switching between time oriented game phases.
+Enter action for WAIT: start the holding animation, LED off.
+@param game game state to operate on.
 */
-static void game_task(void);
+static void enter_wait(Game* game);
 
 
 /**
-Swaps states to the provided game phase enum value.
+Enter action for ENDRESULT: show the game over message, LED on for winner.
+Must run before the phase changes, as the previous phase tells who won.
+@param game game state to operate on.
+*/
+static void enter_endresult(Game* game);
+
+
+/**
+Enter action for PLAY_AGAIN: prompt for a new game.
+@param game game state to operate on.
+*/
+static void enter_play_again(Game* game);
+
+
+/**
+Swaps states to the provided game phase enum value, running its enter action.
+@param game game state to operate on.
 @param new_phase game state to transfer into.
 */
-void change_phase(phase_t new_phase);
+void change_phase(Game* game, phase_t new_phase);
 
 
 /**
 Re-initializes states to re-start game.
+@param game game state to operate on.
 */
-void reset_game(void);
+void reset_game(Game* game);
 
 
 /**
@@ -147,4 +356,56 @@ Get latest navswitch event and return associated direction
 dir_t get_navswitch_dir(void);
 
 
+/**
+Stir the time of an input event into the random pool. The loop tick
+count and timer value together give a 32-bit sample, and the human
+timing of successive events keeps the pool from repeating between games.
+*/
+static void stir_entropy(void);
+
+
+/**
+Send one character of a stats dump over IR.
+@param c character to send
+*/
+static void stats_put(char c);
+
+
+/**
+Scale a count over loop ticks to a rate per second. The count is divided
+before it is scaled, so this cannot overflow while ticks < 2^32 / LOOP_RATE.
+@param count events counted
+@param ticks loop ticks they were counted over, nonzero
+@return events per second
+*/
+static uint32_t per_second(uint32_t count, uint32_t ticks);
+
+
+/**
+Send the profiler statistics over IR, one line per task (in task_table
+order) and per phase (in phase_t order), then one line per counter (see
+the README). Sending blocks for a while, so
+this tick is left out of the statistics and loop pacing restarts after.
+*/
+static void stats_dump(void);
+
+
+/**
+CPU usage of the game loop while in a phase, since power on. Resolution is
+one timer tick per loop, rounded down.
+@param phase game phase to report
+@return percentage of each loop tick spent running tasks
+*/
+uint8_t get_phase_load(phase_t phase);
+
+
+/**
+Number of loop ticks that overran the LOOP_RATE deadline while in a
+phase, since power on. Loop jitter is available from idle_get_jitter.
+@param phase game phase to report
+@return missed deadlines
+*/
+uint16_t get_phase_misses(phase_t phase);
+
+
 #endif
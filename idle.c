@@ -0,0 +1,203 @@
+/**
+@file       idle.c
+@authors    Jordan Griffiths (jlg108) & Jonty Trombik (jat157)
+@date       17 October 2026
+
+@brief      Loop pacing with idle sleep. Timer/counter1 keeps counting for
+            timer_get while a compare match on it wakes the MCU from idle
+            sleep at each loop deadline.
+**/
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include "idle.h"
+
+
+/** Timer/counter1 clock select bits for IDLE_TIMER_DIVISOR */
+#if IDLE_TIMER_DIVISOR == 1
+#define IDLE_CLOCK_SELECT BIT(CS10)
+#elif IDLE_TIMER_DIVISOR == 8
+#define IDLE_CLOCK_SELECT BIT(CS11)
+#elif IDLE_TIMER_DIVISOR == 64
+#define IDLE_CLOCK_SELECT (BIT(CS11) | BIT(CS10))
+#elif IDLE_TIMER_DIVISOR == 256
+#define IDLE_CLOCK_SELECT BIT(CS12)
+#elif IDLE_TIMER_DIVISOR == 1024
+#define IDLE_CLOCK_SELECT (BIT(CS12) | BIT(CS10))
+#else
+#error "IDLE_TIMER_DIVISOR must be 1, 8, 64, 256 or 1024"
+#endif
+
+
+/** Pacing state */
+static timer_tick_t period;             //Timer ticks per loop
+static timer_tick_t deadline;           //Timer value at which the next loop is due
+static uint16_t loops_per_second;       //Loops between idle time samples
+
+
+/** Idle time instrumentation */
+static uint16_t loop_count;             //Loops counted in the current second
+static uint32_t idle_ticks;             //Timer ticks asleep in the current second
+static uint8_t sleep_percent;           //Percentage of the last full second asleep
+static uint32_t sleep_percent_total;    //Sum of sleep_percent over every full second
+static uint32_t seconds;                //Full seconds since idle_init
+
+
+/** Deadline instrumentation */
+static uint32_t misses;                 //Loops that reached idle_wait after their deadline
+static timer_tick_t last_wake;          //Timer value when the last loop started
+static uint8_t jitter_skips;            //Loop intervals still to leave out of the histogram
+static uint16_t jitter[IDLE_JITTER_BUCKETS]; //Loop intervals by log2 of distance from the period
+
+
+/** Compare match only needs to wake the MCU */
+EMPTY_INTERRUPT(TIMER1_COMPA_vect);
+
+
+/**
+Initialise loop pacing, and switch timer_get to IDLE_TIMER_RATE
+@param rate loop rate (Hz), at least 2 * IDLE_TIMER_RATE / 65536
+*/
+void idle_init(uint16_t rate)
+{
+    timer_init();
+    TCCR1B = (TCCR1B & ~(BIT(CS12) | BIT(CS11) | BIT(CS10))) | IDLE_CLOCK_SELECT;
+    period = IDLE_TIMER_RATE / rate;
+    loops_per_second = rate;
+    deadline = timer_get() + period;
+    jitter_skips = 1;
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    TIMSK1 |= BIT(OCIE1A);
+    sei();
+}
+
+
+/**
+Count a loop interval in the jitter histogram
+@param interval timer ticks between the starts of two loops
+*/
+static void idle_count_jitter(timer_tick_t interval)
+{
+    timer_tick_t error = interval > period ? interval - period : period - interval;
+    uint8_t bucket = 0;
+    while (error && bucket < IDLE_JITTER_BUCKETS - 1) {
+        error >>= 1;
+        bucket++;
+    }
+    if (jitter[bucket] < UINT16_MAX) {
+        jitter[bucket]++;
+    }
+}
+
+
+/**
+Sleep until the next loop deadline. Returns straight away if the
+deadline has already passed, which counts as a missed deadline (reaching
+it exactly on the deadline does not).
+@return TRUE if the loop that just ran missed its deadline
+*/
+bool idle_wait(void)
+{
+    timer_tick_t start = timer_get();
+    bool missed = (int16_t) (start - deadline) > 0;
+
+    if (missed) {
+        misses++;
+    }
+
+    OCR1A = deadline;
+    TIFR1 = BIT(OCF1A);
+    for (;;) {
+        //Interrupts stay off from the deadline check until the sleep
+        //instruction, so a match in between still wakes the MCU. Other
+        //interrupts (e.g. the display's plane switch) just loop back here
+        cli();
+        if ((int16_t) (timer_get() - deadline) >= 0) {
+            sei();
+            break;
+        }
+        sleep_enable();
+        sei();
+        sleep_cpu();
+        sleep_disable();
+    }
+
+    idle_ticks += (timer_tick_t) (timer_get() - start);
+    deadline += period;
+
+    start = timer_get();
+    if (jitter_skips > 0) {
+        jitter_skips--;
+    } else {
+        idle_count_jitter(start - last_wake);
+    }
+    last_wake = start;
+
+    loop_count++;
+    if (loop_count >= loops_per_second) {
+        sleep_percent = idle_ticks * 100 / IDLE_TIMER_RATE;
+        sleep_percent_total += sleep_percent;
+        seconds++;
+        idle_ticks = 0;
+        loop_count = 0;
+    }
+
+    return missed;
+}
+
+
+/**
+Restart loop pacing from now, dropping any loop deadlines missed while
+the loop was held up on purpose (e.g. by a blocking debug dump)
+*/
+void idle_restart(void)
+{
+    deadline = timer_get() + period;
+    jitter_skips = 1;
+}
+
+
+/**
+Time spent asleep in the last full second, the CPU headroom left over by
+the game loop
+@return percentage of the second spent asleep
+*/
+uint8_t idle_get_sleep_percent(void)
+{
+    return sleep_percent;
+}
+
+
+/**
+Time spent asleep, averaged over every full second since idle_init
+@return percentage of time spent asleep
+*/
+uint8_t idle_get_sleep_average(void)
+{
+    return seconds ? sleep_percent_total / seconds : 0;
+}
+
+
+/**
+Number of loops that missed their deadline since idle_init
+@return missed deadlines
+*/
+uint32_t idle_get_misses(void)
+{
+    return misses;
+}
+
+
+/**
+Read one bucket of the loop jitter histogram. Bucket 0 counts loops that
+started exactly one period after the previous one; bucket n counts loops
+whose interval was off by 2^(n-1) to 2^n - 1 timer ticks, with the last
+bucket also taking anything further off. Counts saturate at UINT16_MAX.
+@param bucket histogram bucket, less than IDLE_JITTER_BUCKETS
+@return loops counted in the bucket since idle_init
+*/
+uint16_t idle_get_jitter(uint8_t bucket)
+{
+    return jitter[bucket];
+}
@@ -0,0 +1,94 @@
+/**
+@file       idle.h
+@authors    Jordan Griffiths (jlg108) & Jonty Trombik (jat157)
+@date       17 October 2026
+
+@brief      Loop pacing with idle sleep definitions. Stands in for the
+            pacer module: instead of polling the timer until the next loop
+            deadline, the MCU sleeps until a timer compare match wakes it.
+**/
+
+#ifndef IDLE_H
+#define IDLE_H
+
+
+/** Required library modules */
+#include "system.h"
+#include "timer.h"
+
+
+/**
+Timer/counter1 prescaler set by idle_init, in place of the timer driver's
+TIMER_CLOCK_DIVISOR. The finer tick lets the profiler time tasks shorter
+than the driver's 1024 cycle tick; build with -DIDLE_TIMER_DIVISOR=1024
+to get the driver's tick back. timer_get() then wraps every 65536 ticks
+(65 ms at 8 MHz), so the loop period and any deliberate stall measured
+with it must be shorter than half that.
+*/
+#ifndef IDLE_TIMER_DIVISOR
+#define IDLE_TIMER_DIVISOR 8
+#endif
+#define IDLE_TIMER_RATE (F_CPU / IDLE_TIMER_DIVISOR)
+
+
+/** Number of log2 buckets in the loop jitter histogram */
+#define IDLE_JITTER_BUCKETS 12
+
+
+/**
+Initialise loop pacing, and switch timer_get to IDLE_TIMER_RATE
+@param rate loop rate (Hz), at least 2 * IDLE_TIMER_RATE / 65536
+*/
+void idle_init(uint16_t rate);
+
+
+/**
+Sleep until the next loop deadline. Returns straight away if the
+deadline has already passed, which counts as a missed deadline (reaching
+it exactly on the deadline does not).
+@return TRUE if the loop that just ran missed its deadline
+*/
+bool idle_wait(void);
+
+
+/**
+Restart loop pacing from now, dropping any loop deadlines missed while
+the loop was held up on purpose (e.g. by a blocking debug dump)
+*/
+void idle_restart(void);
+
+
+/**
+Time spent asleep in the last full second, the CPU headroom left over by
+the game loop
+@return percentage of the second spent asleep
+*/
+uint8_t idle_get_sleep_percent(void);
+
+
+/**
+Time spent asleep, averaged over every full second since idle_init
+@return percentage of time spent asleep
+*/
+uint8_t idle_get_sleep_average(void);
+
+
+/**
+Number of loops that missed their deadline since idle_init
+@return missed deadlines
+*/
+uint32_t idle_get_misses(void);
+
+
+/**
+Read one bucket of the loop jitter histogram. Bucket 0 counts loops that
+started exactly one period after the previous one; bucket n counts loops
+whose interval was off by 2^(n-1) to 2^n - 1 timer ticks, with the last
+bucket also taking anything further off. Counts saturate at UINT16_MAX.
+@param bucket histogram bucket, less than IDLE_JITTER_BUCKETS
+@return loops counted in the bucket since idle_init
+*/
+uint16_t idle_get_jitter(uint8_t bucket);
+
+
+#endif
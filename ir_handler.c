@@ -3,23 +3,20 @@
 @authors    Jordan Griffiths (jlg108) & Jonty Trombik (jat157)
 @date       27 SEPT 2015
 
-@brief      IR handling and message manipulation
+@brief      IR handling and message manipulation. Messages are carried
+            by the ir_link layer, so each one arrives exactly once.
 */
 
 #include "ir_handler.h"
 
 
-/** Received character variable */
-static int8_t rcvChar;
-
-
 /**
 Send a given status character to other player
 @param status status code to be transmitted
  */
 void ir_send_status(states status)
 {
-    ir_uart_putc(status);
+    ir_link_send(status);
 }
 
 
@@ -30,12 +27,8 @@ no response).
  */
 states ir_get_status(void)
 {
-    if (ir_uart_read_ready_p ()) {
-        rcvChar =  ir_uart_getc();
-        return rcvChar;
-    }
-
-    return NORESPONSE_S;
+    uint8_t status = ir_link_receive();
+    return status == IR_LINK_EMPTY ? NORESPONSE_S : status;
 }
 
 
@@ -45,8 +38,7 @@ Encodes position as 0b00xxxyyy and transmits as character.
 */
 void ir_send_strike(tinygl_point_t pos)
 {
-    char msg = ENCODE_POS(pos.x, pos.y);
-    ir_uart_putc(msg);
+    ir_link_send(ENCODE_POS(pos.x, pos.y));
 }
 
 
@@ -57,12 +49,8 @@ integer if nothing received
 */
 uint8_t ir_get_position(void)
 {
-    if (ir_uart_read_ready_p ()) {
-        char rcvdChar =  ir_uart_getc();
-        return (uint8_t) rcvdChar;
-    }
-
-    return NO_POSITION;
+    uint8_t position = ir_link_receive();
+    return position == IR_LINK_EMPTY ? NO_POSITION : position;
 }
 
 
@@ -76,3 +64,43 @@ tinygl_point_t ir_decode_strike(char pos)
     uint8_t y = DECODE_Y(pos);
     return tinygl_point(x, y);
 }
+
+
+/**
+Convert a strike result into the status code that reports it
+@param result outcome of strike
+@return HIT_S, MISS_S, SUNK_S or FLEET_SUNK_S
+*/
+states ir_encode_result(strike_result_t result)
+{
+    switch (result) {
+        case HIT :
+            return HIT_S;
+        case SUNK :
+            return SUNK_S;
+        case FLEET_SUNK :
+            return FLEET_SUNK_S;
+        default :
+            return MISS_S;
+    }
+}
+
+
+/**
+Convert a received status code into the strike result it reports
+@param status status code received in reply to a strike
+@return outcome of strike (MISS for any status that is not a result)
+*/
+strike_result_t ir_decode_result(states status)
+{
+    switch (status) {
+        case HIT_S :
+            return HIT;
+        case SUNK_S :
+            return SUNK;
+        case FLEET_SUNK_S :
+            return FLEET_SUNK;
+        default :
+            return MISS;
+    }
+}
@@ -15,6 +15,11 @@
 #include "tinygl.h"
 
 
+/** Required application modules */
+#include "board.h"
+#include "ir_link.h"
+
+
 /** Special character to represent nothing received */
 #define NO_POSITION  0xff
 
@@ -32,9 +37,9 @@ typedef enum
     PLAYER_TWO_S,           //Sent to tell other player they are player 2 (and to begin in wait phase)
     HIT_S,                  //Sent to communicate the requested strike was a hit
     MISS_S,                 //Sent to communicate the requested strike was a miss
-    LOSER_S,                //Sent after players turn, to indicate they won and game is over
-    PLAYON_S,               //Sent after players turn, to continue play
-    PLAY_AGAIN_S            //Sent when a new game is requested
+    PLAY_AGAIN_S,           //Sent when a new game is requested
+    SUNK_S,                 //Sent to communicate the requested strike sank a ship
+    FLEET_SUNK_S            //Sent to communicate the requested strike sank the last ship (game over)
 
 } states;
 
@@ -69,6 +74,22 @@ integer if nothing received
 tinygl_point_t ir_decode_strike(char c);
 
 
+/**
+Convert a strike result into the status code that reports it
+@param result outcome of strike
+@return HIT_S, MISS_S, SUNK_S or FLEET_SUNK_S
+*/
+states ir_encode_result(strike_result_t result);
+
+
+/**
+Convert a received status code into the strike result it reports
+@param status status code received in reply to a strike
+@return outcome of strike (MISS for any status that is not a result)
+*/
+strike_result_t ir_decode_result(states status);
+
+
 /**
 Decode a received position character 0b00xxxyyy into its x and y components
 @return a tinygl_point representing this position
@@ -0,0 +1,309 @@
+/**
+@file       ir_link.c
+@authors    Jordan Griffiths (jlg108) & Jonty Trombik (jat157)
+@date       17 October 2026
+
+@brief      IR link layer. Frames are written one byte per call to
+            ir_link_task, so sending never blocks the game loop, and are
+            parsed a byte at a time as they arrive. Bytes outside a valid
+            frame are ignored, and a start byte always begins a new frame,
+            so the parser recovers from a lost byte at the next frame.
+**/
+
+#include "ir_link.h"
+
+
+/** Sender states */
+typedef enum link_tx_state {
+    LINK_IDLE,                          //No message in flight
+    LINK_WAIT_ACK,                      //Front message sent, awaiting its acknowledgement
+} link_tx_state_t;
+
+
+/** Sender state */
+static uint8_t send_queue[IR_LINK_QUEUE_SIZE]; //Messages to send, oldest first
+static uint8_t send_count;              //Messages in send_queue
+static link_tx_state_t tx_state;        //Whether the front message is in flight
+static uint8_t tx_seq;                  //Sequence bit of the front message
+static uint8_t tx_reset;                //IR_LINK_RESET until the first acknowledgement, then 0
+static uint8_t retry_ticks;             //Ticks since the front message was last sent
+static uint16_t retries;                //Retransmissions since ir_link_init
+
+
+/** Raw bytes waiting for the UART (ring buffer) */
+static uint8_t tx_bytes[IR_LINK_TX_SIZE];
+static uint8_t tx_head;                 //Next byte to write to the UART
+static uint8_t tx_count;                //Bytes waiting
+
+
+/** Receiver state */
+static uint8_t rx_frame[IR_LINK_FRAME_SIZE]; //Frame being assembled
+static uint8_t rx_length;               //Bytes of rx_frame received, 0 while hunting for a start byte
+static bool rx_escape;                  //Last byte received was IR_LINK_ESC
+static uint8_t rx_seq;                  //Sequence bit of the next new message expected
+static bool rx_synced;                  //A message has been accepted since ir_link_init
+static bool rx_from_reset;              //The last message accepted came in an IR_LINK_RESET frame
+static uint8_t recv_queue[IR_LINK_QUEUE_SIZE]; //Delivered messages, oldest first
+static uint8_t recv_count;              //Messages in recv_queue
+
+
+/**
+CRC-16 (CCITT polynomial x^16 + x^12 + x^5 + 1, initial value 0xffff) of
+a frame's start, control and payload bytes
+@param control control byte
+@param payload payload byte
+@return CRC-16
+*/
+static uint16_t link_crc(uint8_t control, uint8_t payload)
+{
+    uint16_t crc = 0xffff;
+    uint8_t bytes[3];
+    uint8_t i, bit;
+
+    bytes[0] = IR_LINK_START;
+    bytes[1] = control;
+    bytes[2] = payload;
+    for (i = 0; i < 3; i++) {
+        crc ^= (uint16_t) bytes[i] << 8;
+        for (bit = 0; bit < 8; bit++) {
+            crc = crc & 0x8000 ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+
+/**
+Queue one raw byte for the UART
+@param byte byte to queue
+*/
+static void link_put_byte(uint8_t byte)
+{
+    tx_bytes[(tx_head + tx_count) % IR_LINK_TX_SIZE] = byte;
+    tx_count++;
+}
+
+
+/**
+Queue a whole frame for the UART, escaped, unless there is no room for it
+@param control control byte
+@param payload payload byte
+*/
+static void link_put_frame(uint8_t control, uint8_t payload)
+{
+    uint8_t frame[IR_LINK_FRAME_SIZE];
+    uint16_t crc = link_crc(control, payload);
+    uint8_t i;
+
+    if (tx_count + IR_LINK_FRAME_MAX > IR_LINK_TX_SIZE) {
+        //Dropped frames are recovered by retransmission
+        return;
+    }
+
+    frame[0] = IR_LINK_START;
+    frame[1] = control;
+    frame[2] = payload;
+    frame[3] = crc >> 8;
+    frame[4] = crc & 0xff;
+    link_put_byte(frame[0]);
+    for (i = 1; i < IR_LINK_FRAME_SIZE; i++) {
+        if (frame[i] == IR_LINK_START || frame[i] == IR_LINK_ESC) {
+            link_put_byte(IR_LINK_ESC);
+            link_put_byte(frame[i] ^ IR_LINK_ESC_XOR);
+        } else {
+            link_put_byte(frame[i]);
+        }
+    }
+}
+
+
+/**
+Act on a complete frame with a valid CRC
+@param control control byte
+@param payload payload byte
+*/
+static void link_handle_frame(uint8_t control, uint8_t payload)
+{
+    uint8_t seq = control & IR_LINK_SEQ;
+    uint8_t i;
+
+    if (control & IR_LINK_ACK) {
+        if (tx_state == LINK_WAIT_ACK && seq == tx_seq) {
+            for (i = 1; i < send_count; i++) {
+                send_queue[i - 1] = send_queue[i];
+            }
+            send_count--;
+            tx_seq ^= IR_LINK_SEQ;
+            tx_reset = 0;
+            tx_state = LINK_IDLE;
+        }
+        return;
+    }
+
+    //A reset sender starts afresh, and a reset receiver takes whatever comes first
+    if (!rx_synced || (control & IR_LINK_RESET ? !rx_from_reset : seq == rx_seq)) {
+        if (recv_count == IR_LINK_QUEUE_SIZE) {
+            //No room: leave unacknowledged so the sender tries again later
+            return;
+        }
+        recv_queue[recv_count++] = payload;
+        rx_seq = seq ^ IR_LINK_SEQ;
+        rx_synced = 1;
+        rx_from_reset = (control & IR_LINK_RESET) != 0;
+    }
+    //Repeats of the last message are acknowledged again, as the first ACK was lost
+    link_put_frame(IR_LINK_ACK | seq, 0);
+}
+
+
+/**
+Feed one received byte to the frame parser
+@param byte received byte
+*/
+static void link_receive_byte(uint8_t byte)
+{
+    if (byte == IR_LINK_START) {
+        //Start bytes are never sent inside a frame, so drop any partial frame
+        rx_frame[0] = byte;
+        rx_length = 1;
+        rx_escape = 0;
+        return;
+    }
+    if (rx_length == 0) {
+        return;
+    }
+    if (byte == IR_LINK_ESC) {
+        rx_escape = 1;
+        return;
+    }
+    if (rx_escape) {
+        byte ^= IR_LINK_ESC_XOR;
+        rx_escape = 0;
+    }
+
+    rx_frame[rx_length++] = byte;
+    if (rx_length == IR_LINK_FRAME_SIZE) {
+        rx_length = 0;
+        if ((rx_frame[1] & ~(IR_LINK_ACK | IR_LINK_RESET | IR_LINK_SEQ)) == 0
+            && ((uint16_t) rx_frame[3] << 8 | rx_frame[4]) == link_crc(rx_frame[1], rx_frame[2])) {
+            link_handle_frame(rx_frame[1], rx_frame[2]);
+        }
+    }
+}
+
+
+/**
+Initialise the IR UART and link state
+*/
+void ir_link_init(void)
+{
+    ir_uart_init();
+    send_count = 0;
+    tx_state = LINK_IDLE;
+    tx_seq = 0;
+    tx_reset = IR_LINK_RESET;
+    retries = 0;
+    tx_head = 0;
+    tx_count = 0;
+    rx_length = 0;
+    rx_escape = 0;
+    rx_seq = 0;
+    rx_synced = 0;
+    rx_from_reset = 0;
+    recv_count = 0;
+}
+
+
+/**
+Service the link: read and acknowledge incoming frames, retransmit an
+unacknowledged frame once IR_LINK_RETRY_TICKS have passed, and pass at
+most one byte to the UART. Must be called on every game loop tick, in
+every phase, so that frames are acknowledged promptly.
+*/
+void ir_link_task(void)
+{
+    while (ir_uart_read_ready_p()) {
+        link_receive_byte(ir_uart_getc());
+    }
+
+    if (tx_state == LINK_WAIT_ACK) {
+        retry_ticks++;
+        if (retry_ticks >= IR_LINK_RETRY_TICKS) {
+            retries++;
+            retry_ticks = 0;
+            link_put_frame(tx_reset | tx_seq, send_queue[0]);
+        }
+    } else if (send_count > 0) {
+        retry_ticks = 0;
+        tx_state = LINK_WAIT_ACK;
+        link_put_frame(tx_reset | tx_seq, send_queue[0]);
+    }
+
+    if (tx_count > 0 && ir_uart_write_ready_p()) {
+        ir_uart_putc(tx_bytes[tx_head]);
+        tx_head = (tx_head + 1) % IR_LINK_TX_SIZE;
+        tx_count--;
+    }
+}
+
+
+/**
+Queue a message for reliable delivery
+@param payload message byte (any value but IR_LINK_EMPTY)
+@return TRUE (1) if queued, FALSE (0) if the send queue is full
+*/
+bool ir_link_send(uint8_t payload)
+{
+    if (send_count == IR_LINK_QUEUE_SIZE) {
+        return 0;
+    }
+    send_queue[send_count++] = payload;
+    return 1;
+}
+
+
+/**
+Take the next message delivered by the other board
+@return message byte, or IR_LINK_EMPTY if none is waiting
+*/
+uint8_t ir_link_receive(void)
+{
+    uint8_t payload, i;
+
+    if (recv_count == 0) {
+        return IR_LINK_EMPTY;
+    }
+
+    payload = recv_queue[0];
+    for (i = 1; i < recv_count; i++) {
+        recv_queue[i - 1] = recv_queue[i];
+    }
+    recv_count--;
+    return payload;
+}
+
+
+/**
+Write every byte waiting for the UART, blocking until they are all
+sent. Call before writing to the UART directly, so those bytes do not
+land in the middle of a frame.
+*/
+void ir_link_flush(void)
+{
+    while (tx_count > 0) {
+        //ir_uart_putc waits for the UART to be ready
+        ir_uart_putc(tx_bytes[tx_head]);
+        tx_head = (tx_head + 1) % IR_LINK_TX_SIZE;
+        tx_count--;
+    }
+}
+
+
+/**
+Number of frames sent again after no acknowledgement, since ir_link_init
+@return retransmissions
+*/
+uint16_t ir_link_get_retries(void)
+{
+    return retries;
+}
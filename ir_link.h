@@ -0,0 +1,106 @@
+/**
+@file       ir_link.h
+@authors    Jordan Griffiths (jlg108) & Jonty Trombik (jat157)
+@date       17 October 2026
+
+@brief      IR link layer definitions. Each message byte travels in a
+            frame with a sequence bit and a CRC-16, and is retransmitted
+            until the other board acknowledges it (stop-and-wait).
+
+            The sequence bit only tells a new message from a repeat of the
+            last one, so each side must know where the other is. A board's
+            first frames after ir_link_init carry IR_LINK_RESET, which the
+            other board takes as a new message whatever its sequence bit,
+            and a board that has not yet received a frame since
+            ir_link_init accepts the first one it gets. That keeps the two
+            in step when only one board resets, with two exceptions: a
+            repeat of a message delivered just before the receiver reset
+            is delivered again, and a board that resets again before any
+            message after its previous IR_LINK_RESET frame was delivered
+            has its first message taken as a repeat and dropped.
+**/
+
+#ifndef IR_LINK_H
+#define IR_LINK_H
+
+
+/** Required library modules */
+#include "system.h"
+#include "ir_uart.h"
+
+
+/** Returned by ir_link_receive when no message is waiting */
+#define IR_LINK_EMPTY 0xff
+
+
+/**
+Frame layout: start byte, control byte, payload byte, then the CRC-16 of
+the start, control and payload bytes, high byte first. Any start or
+escape byte after the start is sent as IR_LINK_ESC followed by the byte
+XOR IR_LINK_ESC_XOR, so a start byte on the line always begins a frame.
+*/
+#define IR_LINK_START 0xa5
+#define IR_LINK_ESC 0xa6
+#define IR_LINK_ESC_XOR 0x20
+#define IR_LINK_ACK 0x80                //Control flag for acknowledgement frames
+#define IR_LINK_RESET 0x40              //Control flag for frames sent before the first acknowledgement
+#define IR_LINK_SEQ 0x01                //Control bit holding the sequence number
+#define IR_LINK_FRAME_SIZE 5            //Frame bytes before escaping
+#define IR_LINK_FRAME_MAX 9             //Frame bytes on the line, at worst
+
+
+/** Queue sizes */
+#define IR_LINK_QUEUE_SIZE 4            //Messages waiting to be sent, or to be read
+#define IR_LINK_TX_SIZE 32              //Raw bytes waiting for the UART
+
+
+/** ir_link_task calls before an unacknowledged frame is sent again (100 ms at 300 Hz) */
+#define IR_LINK_RETRY_TICKS 30
+
+
+/**
+Initialise the IR UART and link state
+*/
+void ir_link_init(void);
+
+
+/**
+Service the link: read and acknowledge incoming frames, retransmit an
+unacknowledged frame once IR_LINK_RETRY_TICKS have passed, and pass at
+most one byte to the UART. Must be called on every game loop tick, in
+every phase, so that frames are acknowledged promptly.
+*/
+void ir_link_task(void);
+
+
+/**
+Queue a message for reliable delivery
+@param payload message byte (any value but IR_LINK_EMPTY)
+@return TRUE (1) if queued, FALSE (0) if the send queue is full
+*/
+bool ir_link_send(uint8_t payload);
+
+
+/**
+Take the next message delivered by the other board
+@return message byte, or IR_LINK_EMPTY if none is waiting
+*/
+uint8_t ir_link_receive(void);
+
+
+/**
+Write every byte waiting for the UART, blocking until they are all
+sent. Call before writing to the UART directly, so those bytes do not
+land in the middle of a frame.
+*/
+void ir_link_flush(void);
+
+
+/**
+Number of frames sent again after no acknowledgement, since ir_link_init
+@return retransmissions
+*/
+uint16_t ir_link_get_retries(void);
+
+
+#endif
@@ -0,0 +1,112 @@
+/**
+@file       messages.c
+@authors    Jordan Griffiths (jlg108) & Jonty Trombik (jat157)
+@date       17 October 2026
+
+@brief      Pre-rendered status messages. Text is rendered from 3x5
+            capitals with a blank column between characters, including the
+            leading and trailing spaces tinygl used to pad each message.
+            Generated by bench/gen_messages.c from font3x5_1; edit the
+            messages there.
+**/
+
+#include "messages.h"
+
+
+/** "READY?" (32 columns) */
+static const uint8_t ready_strips[] PROGMEM =
+{
+    0x00, 0x56, 0x26, 0x67, 0x00, 0x00,
+    0x00, 0x51, 0x55, 0x54, 0x00, 0x00,
+    0x00, 0x22, 0x75, 0x66, 0x00, 0x00,
+    0x00, 0x20, 0x55, 0x54, 0x00, 0x00,
+    0x00, 0x22, 0x56, 0x57, 0x00, 0x00,
+};
+
+
+/** "YOU WIN!" (48 columns) */
+static const uint8_t win_strips[] PROGMEM =
+{
+    0x00, 0x00, 0x62, 0x57, 0x50, 0x52, 0x00, 0x00,
+    0x00, 0x00, 0x52, 0x52, 0x50, 0x55, 0x00, 0x00,
+    0x00, 0x00, 0x52, 0x72, 0x50, 0x25, 0x00, 0x00,
+    0x00, 0x00, 0x50, 0x72, 0x50, 0x25, 0x00, 0x00,
+    0x00, 0x00, 0x52, 0x57, 0x70, 0x22, 0x00, 0x00,
+};
+
+
+/** "YOU LOSE!" (48 columns) */
+static const uint8_t lose_strips[] PROGMEM =
+{
+    0x00, 0x20, 0x37, 0x42, 0x50, 0x52, 0x00, 0x00,
+    0x00, 0x20, 0x44, 0x45, 0x50, 0x55, 0x00, 0x00,
+    0x00, 0x20, 0x26, 0x45, 0x50, 0x25, 0x00, 0x00,
+    0x00, 0x00, 0x14, 0x45, 0x50, 0x25, 0x00, 0x00,
+    0x00, 0x20, 0x67, 0x72, 0x70, 0x22, 0x00, 0x00,
+};
+
+
+/** "PUSH TO PLAY AGAIN!" (84 columns) */
+static const uint8_t play_again_strips[] PROGMEM =
+{
+    0x00, 0x62, 0x27, 0x23, 0x50, 0x42, 0x06, 0x72, 0x50, 0x53, 0x06, 0x00, 0x00,
+    0x00, 0x52, 0x52, 0x54, 0x50, 0x45, 0x05, 0x25, 0x50, 0x54, 0x05, 0x00, 0x00,
+    0x00, 0x52, 0x72, 0x75, 0x20, 0x47, 0x06, 0x25, 0x70, 0x52, 0x06, 0x00, 0x00,
+    0x00, 0x50, 0x52, 0x55, 0x20, 0x45, 0x04, 0x25, 0x50, 0x51, 0x04, 0x00, 0x00,
+    0x00, 0x52, 0x57, 0x53, 0x20, 0x75, 0x04, 0x22, 0x50, 0x76, 0x04, 0x00, 0x00,
+};
+
+
+/** "PUSH TO START!" (64 columns) */
+static const uint8_t start_strips[] PROGMEM =
+{
+    0x00, 0x72, 0x26, 0x37, 0x20, 0x07, 0x35, 0x65, 0x00, 0x00,
+    0x00, 0x22, 0x55, 0x42, 0x50, 0x02, 0x45, 0x55, 0x00, 0x00,
+    0x00, 0x22, 0x76, 0x22, 0x50, 0x02, 0x27, 0x65, 0x00, 0x00,
+    0x00, 0x20, 0x55, 0x12, 0x50, 0x02, 0x15, 0x45, 0x00, 0x00,
+    0x00, 0x22, 0x55, 0x62, 0x20, 0x02, 0x65, 0x47, 0x00, 0x00,
+};
+
+
+/** "HIT" (24 columns) */
+static const uint8_t hit_strips[] PROGMEM =
+{
+    0x05, 0x00, 0x77, 0x05, 0x00,
+    0x05, 0x00, 0x22, 0x05, 0x00,
+    0x07, 0x00, 0x22, 0x07, 0x00,
+    0x05, 0x00, 0x22, 0x05, 0x00,
+    0x05, 0x00, 0x72, 0x05, 0x00,
+};
+
+
+/** "MISS" (20 columns) */
+static const uint8_t miss_strips[] PROGMEM =
+{
+    0x05, 0x33, 0x57, 0x00, 0x00,
+    0x07, 0x44, 0x72, 0x00, 0x00,
+    0x07, 0x22, 0x72, 0x00, 0x00,
+    0x05, 0x11, 0x52, 0x00, 0x00,
+    0x05, 0x66, 0x57, 0x00, 0x00,
+};
+
+
+/** "SUNK" (28 columns) */
+static const uint8_t sunk_strips[] PROGMEM =
+{
+    0x03, 0x00, 0x65, 0x35, 0x00, 0x00,
+    0x04, 0x00, 0x55, 0x45, 0x00, 0x00,
+    0x02, 0x00, 0x56, 0x25, 0x00, 0x00,
+    0x01, 0x00, 0x55, 0x15, 0x00, 0x00,
+    0x06, 0x00, 0x55, 0x67, 0x00, 0x00,
+};
+
+
+/** Messages */
+const Message msg_ready PROGMEM = {ready_strips, 32, 6};
+const Message msg_win PROGMEM = {win_strips, 48, 8};
+const Message msg_lose PROGMEM = {lose_strips, 48, 8};
+const Message msg_play_again PROGMEM = {play_again_strips, 84, 13};
+const Message msg_start PROGMEM = {start_strips, 64, 10};
+const Message msg_hit PROGMEM = {hit_strips, 24, 5};
+const Message msg_miss PROGMEM = {miss_strips, 20, 5};
+const Message msg_sunk PROGMEM = {sunk_strips, 28, 6};
@@ -0,0 +1,49 @@
+/**
+@file       messages.h
+@authors    Jordan Griffiths (jlg108) & Jonty Trombik (jat157)
+@date       17 October 2026
+
+@brief      Pre-rendered status message definitions. Each message is held
+            in program memory as one bit strip per display column, ready to
+            be scrolled by sliding a window along the strips.
+**/
+
+#ifndef MESSAGES_H
+#define MESSAGES_H
+
+
+/** Required library modules */
+#include "system.h"
+#include <avr/pgmspace.h>
+
+
+/** Columns taken by one character of message text (3x5 glyph plus gap) */
+#define MESSAGE_CHAR_COLUMNS 4
+
+
+/**
+Structure definition for a pre-rendered message. The text runs along the
+display rows, rotated as tinygl's TINYGL_TEXT_DIR_ROTATE. Display column
+x has its own strip of stride bytes in which bit (length + 6 - t) is glyph
+row x of text column t. The first DISPLAY_HEIGHT text columns are repeated
+at the end of each strip so that the window wraps without a seam.
+*/
+typedef struct message {
+    const uint8_t* strips;              //DISPLAY_WIDTH bit strips (program memory)
+    uint8_t length;                     //Number of text columns before the repeat
+    uint8_t stride;                     //Bytes per strip, including one byte of padding
+} Message;
+
+
+/** Status messages (program memory) */
+extern const Message msg_ready PROGMEM;
+extern const Message msg_win PROGMEM;
+extern const Message msg_lose PROGMEM;
+extern const Message msg_play_again PROGMEM;
+extern const Message msg_start PROGMEM;
+extern const Message msg_hit PROGMEM;
+extern const Message msg_miss PROGMEM;
+extern const Message msg_sunk PROGMEM;
+
+
+#endif
@@ -0,0 +1,155 @@
+/**
+@file       profile.c
+@authors    Jordan Griffiths (jlg108) & Jonty Trombik (jat157)
+@date       17 October 2026
+
+@brief      Cycle count profiler. Recording a sample is a few compares and
+            an add, so the profiler can stay enabled in the device build.
+**/
+
+#include "profile.h"
+
+
+/**
+Print a string
+@param put character output routine
+@param text string to print
+*/
+static void put_string(profile_put_t put, const char* text)
+{
+    while (*text) {
+        put(*text++);
+    }
+}
+
+
+/**
+Print an unsigned decimal number
+@param put character output routine
+@param value number to print
+*/
+static void put_number(profile_put_t put, uint32_t value)
+{
+    char digits[10];
+    uint8_t i = 0;
+    do {
+        digits[i++] = '0' + value % 10;
+        value /= 10;
+    } while (value);
+    while (i) {
+        put(digits[--i]);
+    }
+}
+
+
+/**
+Clear a block of statistics
+@param stats statistics to clear
+@param num number of statistics in the block
+*/
+void profile_reset(ProfileStat* stats, uint8_t num)
+{
+    uint8_t i;
+    for (i = 0; i < num; i++) {
+        stats[i].min = UINT16_MAX;
+        stats[i].max = 0;
+        stats[i].total = 0;
+        stats[i].count = 0;
+    }
+}
+
+
+/**
+Add a sample to a statistic
+@param stat statistic to update
+@param ticks timer ticks taken by the sampled code
+*/
+void profile_record(ProfileStat* stat, timer_tick_t ticks)
+{
+    if (ticks < stat->min) {
+        stat->min = ticks;
+    }
+    if (ticks > stat->max) {
+        stat->max = ticks;
+    }
+    stat->total += ticks;
+    stat->count++;
+}
+
+
+/**
+Average timer ticks per sample of a statistic, scaled by 100
+@param stat statistic to read
+@return average ticks times 100, or 0 if there are no samples
+*/
+uint32_t profile_average(ProfileStat* stat)
+{
+    if (stat->count == 0) {
+        return 0;
+    }
+    //Divide first: total * 100 overflows after a minute or so of loop ticks
+    return stat->total / stat->count * 100 + stat->total % stat->count * 100 / stat->count;
+}
+
+
+/**
+Report a block of statistics, one line per statistic, as
+"<label><index> n <count> min <cycles> avg <cycles> max <cycles>"
+@param put character output routine
+@param label label printed before each statistic's index
+@param stats statistics to report
+@param num number of statistics in the block
+*/
+void profile_dump(profile_put_t put, const char* label, ProfileStat* stats, uint8_t num)
+{
+    uint8_t i;
+    for (i = 0; i < num; i++) {
+        ProfileStat* stat = &stats[i];
+        put_string(put, label);
+        put_number(put, i);
+        put_string(put, " n ");
+        put_number(put, stat->count);
+        put_string(put, " min ");
+        put_number(put, stat->count ? (uint32_t) stat->min * PROFILE_CYCLES_PER_TICK : 0);
+        put_string(put, " avg ");
+        put_number(put, profile_average(stat) * PROFILE_CYCLES_PER_TICK / 100);
+        put_string(put, " max ");
+        put_number(put, (uint32_t) stat->max * PROFILE_CYCLES_PER_TICK);
+        put_string(put, "\r\n");
+    }
+}
+
+
+/**
+Report a single value as "<label> <value>"
+@param put character output routine
+@param label label printed before the value
+@param value value to report
+*/
+void profile_dump_value(profile_put_t put, const char* label, uint32_t value)
+{
+    put_string(put, label);
+    put(' ');
+    put_number(put, value);
+    put_string(put, "\r\n");
+}
+
+
+/**
+Report a block of counters, one line per counter, as "<label><index> <count>"
+@param put character output routine
+@param label label printed before each counter's index
+@param counts counters to report
+@param num number of counters in the block
+*/
+void profile_dump_counts(profile_put_t put, const char* label, const uint16_t* counts, uint8_t num)
+{
+    uint8_t i;
+    for (i = 0; i < num; i++) {
+        put_string(put, label);
+        put_number(put, i);
+        put(' ');
+        put_number(put, counts[i]);
+        put_string(put, "\r\n");
+    }
+}
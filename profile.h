@@ -0,0 +1,96 @@
+/**
+@file       profile.h
+@authors    Jordan Griffiths (jlg108) & Jonty Trombik (jat157)
+@date       17 October 2026
+
+@brief      Cycle count profiler definitions. Samples are timer tick
+            counts, kept as min/total/max per statistic and reported in CPU
+            cycles through a character output routine, so the same report
+            can go over the IR UART or to stdout in a host build.
+**/
+
+#ifndef PROFILE_H
+#define PROFILE_H
+
+
+/** Required library modules */
+#include "system.h"
+#include "timer.h"
+
+
+/** Application Modules */
+#include "idle.h"
+
+
+/** CPU cycles per timer tick (the profiler's resolution) */
+#define PROFILE_CYCLES_PER_TICK (F_CPU / IDLE_TIMER_RATE)
+
+
+/** Structure definition for one profiled statistic */
+typedef struct profile_stat {
+    uint16_t min;                       //Fewest timer ticks in one sample
+    uint16_t max;                       //Most timer ticks in one sample
+    uint32_t total;                     //Timer ticks over all samples
+    uint32_t count;                     //Number of samples
+} ProfileStat;
+
+
+/** Character output routine used for reports */
+typedef void (*profile_put_t)(char c);
+
+
+/**
+Clear a block of statistics
+@param stats statistics to clear
+@param num number of statistics in the block
+*/
+void profile_reset(ProfileStat* stats, uint8_t num);
+
+
+/**
+Add a sample to a statistic
+@param stat statistic to update
+@param ticks timer ticks taken by the sampled code
+*/
+void profile_record(ProfileStat* stat, timer_tick_t ticks);
+
+
+/**
+Average timer ticks per sample of a statistic, scaled by 100
+@param stat statistic to read
+@return average ticks times 100, or 0 if there are no samples
+*/
+uint32_t profile_average(ProfileStat* stat);
+
+
+/**
+Report a block of statistics, one line per statistic, as
+"<label><index> n <count> min <cycles> avg <cycles> max <cycles>"
+@param put character output routine
+@param label label printed before each statistic's index
+@param stats statistics to report
+@param num number of statistics in the block
+*/
+void profile_dump(profile_put_t put, const char* label, ProfileStat* stats, uint8_t num);
+
+
+/**
+Report a single value as "<label> <value>"
+@param put character output routine
+@param label label printed before the value
+@param value value to report
+*/
+void profile_dump_value(profile_put_t put, const char* label, uint32_t value);
+
+
+/**
+Report a block of counters, one line per counter, as "<label><index> <count>"
+@param put character output routine
+@param label label printed before each counter's index
+@param counts counters to report
+@param num number of counters in the block
+*/
+void profile_dump_counts(profile_put_t put, const char* label, const uint16_t* counts, uint8_t num);
+
+
+#endif
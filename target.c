@@ -0,0 +1,342 @@
+/**
+@file       target.c
+@authors    Jordan Griffiths (jlg108) & Jonty Trombik (jat157)
+@date       17 October 2026
+
+@brief      Probability density targeting. Placement counts are built in
+            closed form for an empty board and then updated incrementally,
+            visiting only the placements through each struck cell, or of
+            a ship that has just been sunk.
+**/
+
+#include "target.h"
+
+
+/** Fleet being searched for */
+static const uint8_t fleet[NUM_SHIPS] = SHIP_LENGTHS;
+
+
+/**
+Number of start positions of a run of cells along one axis that cover
+a given index.
+@param i index to cover
+@param len length of run
+@param size number of cells along the axis
+@return number of covering start positions
+*/
+static uint8_t span_count(uint8_t i, uint8_t len, uint8_t size)
+{
+    uint8_t first = i + 1 >= len ? i + 1 - len : 0;
+    uint8_t last = i + len <= size ? i : size - len;
+    return last + 1 - first;
+}
+
+
+/**
+Check whether a placement avoids every marked cell of a bitmap
+@param bitmap board bitmap to test against
+@param rot rotation of placement
+@param x column of first cell
+@param y row of first cell
+@param len length of placement
+@return TRUE (1) if no cell of the placement is marked, FALSE (0) otherwise.
+*/
+static bool placement_clear(board_col_t* bitmap, rotation_t rot, uint8_t x, uint8_t y, uint8_t len)
+{
+    uint8_t i;
+    if (rot == VERT) {
+        return !(bitmap[x] & (RUN_MASK(len) << y));
+    }
+    for (i = 0; i < len; i++) {
+        if (bitmap[x + i] & COL_BIT(y)) {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+
+/**
+Add delta to a count map over every cell of a placement
+@param map count map to update
+@param rot rotation of placement
+@param x column of first cell
+@param y row of first cell
+@param len length of placement
+@param delta amount to add (+1 or -1)
+*/
+static void placement_add(uint8_t map[BOARD_WIDTH][BOARD_HEIGHT], rotation_t rot,
+                          uint8_t x, uint8_t y, uint8_t len, int8_t delta)
+{
+    uint8_t i;
+    for (i = 0; i < len; i++) {
+        if (rot == VERT) {
+            map[x][y + i] += delta;
+        } else {
+            map[x + i][y] += delta;
+        }
+    }
+}
+
+
+/**
+Remove one placement from the counts, if not already ruled out
+@param target targeting state to operate on.
+@param rot rotation of placement
+@param x column of first cell
+@param y row of first cell
+@param len length of placement
+*/
+static void placement_remove(Targeter* target, rotation_t rot, uint8_t x, uint8_t y, uint8_t len)
+{
+    if (!placement_clear(target->blocked, rot, x, y, len)) {
+        return;
+    }
+    placement_add(target->counts, rot, x, y, len, -1);
+    if (!placement_clear(target->hits, rot, x, y, len)) {
+        placement_add(target->hit_counts, rot, x, y, len, -1);
+    }
+}
+
+
+/**
+Update counts for one placement through a newly struck cell. Must be
+called before the strike is added to the hit or blocked bitmaps.
+@param target targeting state to operate on.
+@param rot rotation of placement
+@param x column of first cell
+@param y row of first cell
+@param len length of placement
+@param result outcome of strike (hit or miss)
+*/
+static void placement_update(Targeter* target, rotation_t rot, uint8_t x, uint8_t y,
+                             uint8_t len, strike_result_t result)
+{
+    if (result == MISS) {
+        placement_remove(target, rot, x, y, len);
+    } else if (placement_clear(target->blocked, rot, x, y, len)
+               && placement_clear(target->hits, rot, x, y, len)) {
+        //First hit on this placement
+        placement_add(target->hit_counts, rot, x, y, len, 1);
+    }
+}
+
+
+/**
+Update counts for every placement of an afloat ship through a newly
+struck or blocked cell
+@param target targeting state to operate on.
+@param x column of cell
+@param y row of cell
+@param result outcome of strike (MISS for a blocked cell)
+*/
+static void cell_update(Targeter* target, uint8_t x, uint8_t y, strike_result_t result)
+{
+    uint8_t s, start;
+
+    for (s = 0; s < NUM_SHIPS; s++) {
+        uint8_t len = fleet[s];
+        uint8_t first_x = x + 1 >= len ? x + 1 - len : 0;
+        uint8_t first_y = y + 1 >= len ? y + 1 - len : 0;
+
+        if (!(target->afloat & BIT(s))) {
+            continue;
+        }
+        for (start = first_x; start <= x && start + len <= BOARD_WIDTH; start++) {
+            placement_update(target, HORIZ, start, y, len, result);
+        }
+        for (start = first_y; start <= y && start + len <= BOARD_HEIGHT; start++) {
+            placement_update(target, VERT, x, start, len, result);
+        }
+    }
+}
+
+
+/**
+Check whether every cell of a placement is a hit that is not yet blocked
+@param target targeting state to operate on.
+@param rot rotation of placement
+@param x column of first cell
+@param y row of first cell
+@param len length of placement
+@return TRUE (1) if the placement could be a ship just sunk, FALSE (0) otherwise.
+*/
+static bool placement_all_hit(Targeter* target, rotation_t rot, uint8_t x, uint8_t y, uint8_t len)
+{
+    uint8_t i;
+    for (i = 0; i < len; i++) {
+        uint8_t cx = rot == HORIZ ? x + i : x;
+        uint8_t cy = rot == VERT ? y + i : y;
+        if ((target->hits[cx] & ~target->blocked[cx] & COL_BIT(cy)) == 0) {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+
+/**
+Retire the ship sunk by a strike: remove every remaining placement of it
+from the counts, then block its cells for the ships still afloat. Does
+nothing if no afloat ship fits the hits through the struck cell.
+@param target targeting state to operate on.
+@param x column of the sinking strike (already recorded as a hit)
+@param y row of the sinking strike
+*/
+static void retire_sunk(Targeter* target, uint8_t x, uint8_t y)
+{
+    uint8_t sunk = NO_SHIP;
+    uint8_t sunk_x = 0, sunk_y = 0;
+    rotation_t sunk_rot = HORIZ;
+    uint8_t s, start, i, len;
+
+    for (s = 0; s < NUM_SHIPS; s++) {
+        len = fleet[s];
+        if (!(target->afloat & BIT(s)) || (sunk != NO_SHIP && len <= fleet[sunk])) {
+            continue;
+        }
+        for (start = x + 1 >= len ? x + 1 - len : 0; start <= x && start + len <= BOARD_WIDTH; start++) {
+            if (placement_all_hit(target, HORIZ, start, y, len)) {
+                sunk = s;
+                sunk_rot = HORIZ;
+                sunk_x = start;
+                sunk_y = y;
+                break;
+            }
+        }
+        for (start = y + 1 >= len ? y + 1 - len : 0; start <= y && start + len <= BOARD_HEIGHT && sunk != s; start++) {
+            if (placement_all_hit(target, VERT, x, start, len)) {
+                sunk = s;
+                sunk_rot = VERT;
+                sunk_x = x;
+                sunk_y = start;
+            }
+        }
+    }
+    if (sunk == NO_SHIP) {
+        return;
+    }
+
+    //Take the sunk ship out of the fleet being searched for
+    len = fleet[sunk];
+    for (start = 0; start < BOARD_WIDTH; start++) {
+        for (i = 0; i < BOARD_HEIGHT; i++) {
+            if (start + len <= BOARD_WIDTH) {
+                placement_remove(target, HORIZ, start, i, len);
+            }
+            if (i + len <= BOARD_HEIGHT) {
+                placement_remove(target, VERT, start, i, len);
+            }
+        }
+    }
+    target->afloat &= ~BIT(sunk);
+
+    //Its cells can hold no other ship, and no longer point at neighbours
+    for (i = 0; i < len; i++) {
+        uint8_t cx = sunk_rot == HORIZ ? sunk_x + i : sunk_x;
+        uint8_t cy = sunk_rot == VERT ? sunk_y + i : sunk_y;
+        cell_update(target, cx, cy, MISS);
+        target->blocked[cx] |= COL_BIT(cy);
+    }
+}
+
+
+/**
+Reset targeting state for a fresh target board.
+@param target targeting state to operate on.
+*/
+void target_init(Targeter* target)
+{
+    uint8_t x, y, s;
+    for (x = 0; x < BOARD_WIDTH; x++) {
+        target->hits[x] = 0;
+        target->blocked[x] = 0;
+        for (y = 0; y < BOARD_HEIGHT; y++) {
+            uint8_t count = 0;
+            for (s = 0; s < NUM_SHIPS; s++) {
+                count += span_count(x, fleet[s], BOARD_WIDTH);
+                count += span_count(y, fleet[s], BOARD_HEIGHT);
+            }
+            target->counts[x][y] = count;
+            target->hit_counts[x][y] = 0;
+        }
+    }
+    target->afloat = BIT(NUM_SHIPS) - 1;
+}
+
+
+/**
+Update placement counts with the result of a strike. Only placements
+that cover the struck cell are visited, except when the strike sinks a
+ship: the sunk ship is then taken out of the counts, and its cells are
+blocked so they no longer draw strikes to their neighbours. The sunk
+ship is the afloat ship whose cells through the struck cell are all
+hits not already retired, taking the longest when several fit.
+@param target targeting state to operate on.
+@param pos position of strike
+@param result outcome of strike
+*/
+void target_record(Targeter* target, tinygl_point_t pos, strike_result_t result)
+{
+    uint8_t x = pos.x;
+    uint8_t y = pos.y;
+
+    if ((target->hits[x] | target->blocked[x]) & COL_BIT(y)) {
+        return;
+    }
+
+    cell_update(target, x, y, result);
+    if (IS_HIT_RESULT(result)) {
+        target->hits[x] |= COL_BIT(y);
+    } else {
+        target->blocked[x] |= COL_BIT(y);
+    }
+
+    if (result == SUNK || result == FLEET_SUNK) {
+        retire_sunk(target, x, y);
+    }
+}
+
+
+/**
+Score a cell as a candidate for the next strike. Cells next to known hits
+(covered by placements through a hit) outrank all others, then cells with
+more placements outrank fewer.
+@param target targeting state to operate on.
+@param x column of cell
+@param y row of cell
+@return score, or 0 if the cell has already been struck
+*/
+uint16_t target_score(Targeter* target, uint8_t x, uint8_t y)
+{
+    if ((target->hits[x] | target->blocked[x]) & COL_BIT(y)) {
+        return 0;
+    }
+    return ((uint16_t) target->hit_counts[x][y] << 8 | target->counts[x][y]) + 1;
+}
+
+
+/**
+Find the best cell for the next strike, scanning the whole board in one
+call. For host simulation (see bench/bench_target.c); the device AI
+spreads the same scoring over several ticks instead.
+@param target targeting state to operate on.
+@return position of the highest scoring cell (first found on ties)
+*/
+tinygl_point_t target_best(Targeter* target)
+{
+    tinygl_point_t best = tinygl_point(0, 0);
+    uint16_t best_score = 0;
+    uint8_t x, y;
+
+    for (x = 0; x < BOARD_WIDTH; x++) {
+        for (y = 0; y < BOARD_HEIGHT; y++) {
+            uint16_t score = target_score(target, x, y);
+            if (score > best_score) {
+                best_score = score;
+                best = tinygl_point(x, y);
+            }
+        }
+    }
+    return best;
+}
@@ -0,0 +1,82 @@
+/**
+@file       target.h
+@authors    Jordan Griffiths (jlg108) & Jonty Trombik (jat157)
+@date       17 October 2026
+
+@brief      Probability density targeting definitions. For every cell of
+            the target board, counts the fleet placements that are still
+            consistent with the strikes made so far.
+**/
+
+#ifndef TARGET_H
+#define TARGET_H
+
+
+/** Required library modules */
+#include "system.h"
+#include "tinygl.h"
+
+
+/** Application Modules */
+#include "board.h"
+
+
+#if NUM_SHIPS > 8
+#error "Targeter.afloat holds one bit per ship"
+#endif
+
+
+/** Structure definition for targeting state over one target board */
+typedef struct targeter {
+    uint8_t counts[BOARD_WIDTH][BOARD_HEIGHT];      //Placements of afloat ships covering each cell
+    uint8_t hit_counts[BOARD_WIDTH][BOARD_HEIGHT];  //...of which also cover a hit on an afloat ship
+    board_col_t hits[BOARD_WIDTH];                  //Strikes that hit
+    board_col_t blocked[BOARD_WIDTH];               //Cells no afloat ship can cover: misses and sunk ships
+    uint8_t afloat;                                 //Bit s set while fleet ship s is not known to be sunk
+} Targeter;
+
+
+/**
+Reset targeting state for a fresh target board.
+@param target targeting state to operate on.
+*/
+void target_init(Targeter* target);
+
+
+/**
+Update placement counts with the result of a strike. Only placements
+that cover the struck cell are visited, except when the strike sinks a
+ship: the sunk ship is then taken out of the counts, and its cells are
+blocked so they no longer draw strikes to their neighbours. The sunk
+ship is the afloat ship whose cells through the struck cell are all
+hits not already retired, taking the longest when several fit.
+@param target targeting state to operate on.
+@param pos position of strike
+@param result outcome of strike
+*/
+void target_record(Targeter* target, tinygl_point_t pos, strike_result_t result);
+
+
+/**
+Score a cell as a candidate for the next strike. Cells next to known hits
+(covered by placements through a hit) outrank all others, then cells with
+more placements outrank fewer.
+@param target targeting state to operate on.
+@param x column of cell
+@param y row of cell
+@return score, or 0 if the cell has already been struck
+*/
+uint16_t target_score(Targeter* target, uint8_t x, uint8_t y);
+
+
+/**
+Find the best cell for the next strike, scanning the whole board in one
+call. For host simulation (see bench/bench_target.c); the device AI
+spreads the same scoring over several ticks instead.
+@param target targeting state to operate on.
+@return position of the highest scoring cell (first found on ties)
+*/
+tinygl_point_t target_best(Targeter* target);
+
+
+#endif
@@ -0,0 +1,128 @@
+/**
+@file       wheel.c
+@authors    Jordan Griffiths (jlg108) & Jonty Trombik (jat157)
+@date       17 October 2026
+
+@brief      Timer wheel. Each slot holds a list of the timers that fall due
+            on it, with a count of the full turns left before each fires.
+**/
+
+#include "wheel.h"
+
+
+/** Marks the end of a slot list, or a stopped timer */
+#define WHEEL_NONE 0xff
+
+
+/** Structure definition for one wheel timer */
+typedef struct wheel_timer {
+    uint16_t turns;                     //Visits to its slot left before firing
+    uint16_t period;                    //Ticks between firings, 0 if one-shot
+    uint8_t slot;                       //Slot holding the timer, WHEEL_NONE if stopped
+    uint8_t next;                       //Next timer in the same slot
+} WheelTimer;
+
+
+/** Wheel state */
+static WheelTimer timers[WHEEL_TIMERS];
+static uint8_t slots[WHEEL_SLOTS];      //First timer in each slot
+static uint8_t now_slot;                //Slot visited on the last tick
+
+
+/**
+Add a stopped timer to the slot it falls due on
+@param id timer to add
+@param delay ticks until the timer fires (at least 1)
+*/
+static void wheel_insert(uint8_t id, uint16_t delay)
+{
+    uint8_t slot = (now_slot + delay) & (WHEEL_SLOTS - 1);
+    timers[id].turns = (delay - 1) / WHEEL_SLOTS;
+    timers[id].slot = slot;
+    timers[id].next = slots[slot];
+    slots[slot] = id;
+}
+
+
+/**
+Reset the wheel with every timer stopped
+*/
+void wheel_init(void)
+{
+    uint8_t i;
+    for (i = 0; i < WHEEL_SLOTS; i++) {
+        slots[i] = WHEEL_NONE;
+    }
+    for (i = 0; i < WHEEL_TIMERS; i++) {
+        timers[i].slot = WHEEL_NONE;
+    }
+    now_slot = 0;
+}
+
+
+/**
+Start (or restart) a timer
+@param id timer to start, less than WHEEL_TIMERS
+@param delay ticks until the timer first fires (at least 1)
+@param period ticks between later firings, or 0 for a one-shot timer
+*/
+void wheel_start(uint8_t id, uint16_t delay, uint16_t period)
+{
+    wheel_stop(id);
+    timers[id].period = period;
+    wheel_insert(id, delay ? delay : 1);
+}
+
+
+/**
+Stop a timer, if running
+@param id timer to stop
+*/
+void wheel_stop(uint8_t id)
+{
+    uint8_t* link;
+    if (timers[id].slot == WHEEL_NONE) {
+        return;
+    }
+
+    link = &slots[timers[id].slot];
+    while (*link != id) {
+        link = &timers[*link].next;
+    }
+    *link = timers[id].next;
+    timers[id].slot = WHEEL_NONE;
+}
+
+
+/**
+Advance the wheel by one tick. Must be called once per game loop tick.
+@return mask of timers that fired on this tick (bit n for timer n)
+*/
+uint8_t wheel_tick(void)
+{
+    uint8_t fired = 0;
+    uint8_t id;
+
+    now_slot = (now_slot + 1) & (WHEEL_SLOTS - 1);
+    id = slots[now_slot];
+    slots[now_slot] = WHEEL_NONE;
+
+    //Timers put back on this slot are only seen again after a full turn
+    while (id != WHEEL_NONE) {
+        uint8_t next = timers[id].next;
+        if (timers[id].turns > 0) {
+            timers[id].turns--;
+            timers[id].next = slots[now_slot];
+            slots[now_slot] = id;
+        } else {
+            fired |= BIT(id);
+            timers[id].slot = WHEEL_NONE;
+            if (timers[id].period) {
+                wheel_insert(id, timers[id].period);
+            }
+        }
+        id = next;
+    }
+
+    return fired;
+}
@@ -0,0 +1,53 @@
+/**
+@file       wheel.h
+@authors    Jordan Griffiths (jlg108) & Jonty Trombik (jat157)
+@date       17 October 2026
+
+@brief      Timer wheel definitions. One-shot and periodic deadlines are
+            counted in game loop ticks and hashed into wheel slots, so each
+            tick only visits the timers due in one slot.
+**/
+
+#ifndef WHEEL_H
+#define WHEEL_H
+
+
+/** Required library modules */
+#include "system.h"
+
+
+/** Wheel size (slots must be a power of two) */
+#define WHEEL_SLOTS 16
+#define WHEEL_TIMERS 8
+
+
+/**
+Reset the wheel with every timer stopped
+*/
+void wheel_init(void);
+
+
+/**
+Start (or restart) a timer
+@param id timer to start, less than WHEEL_TIMERS
+@param delay ticks until the timer first fires (at least 1)
+@param period ticks between later firings, or 0 for a one-shot timer
+*/
+void wheel_start(uint8_t id, uint16_t delay, uint16_t period);
+
+
+/**
+Stop a timer, if running
+@param id timer to stop
+*/
+void wheel_stop(uint8_t id);
+
+
+/**
+Advance the wheel by one tick. Must be called once per game loop tick.
+@return mask of timers that fired on this tick (bit n for timer n)
+*/
+uint8_t wheel_tick(void);
+
+
+#endif